@@ -116,11 +116,13 @@
  *   - 5029: Adding implicit parameter to work descriptor flags.
  *   - 5030: Adding instrumentation support to wrap main function.
  *   - 5041: Adding mandatory taskwait to support devices tasks in final mode.
+ *   - 5042: Bulk work descriptor creation and submission services.
  * - nanos interface family: worksharing
  *   - 1000: First implementation of work-sharing services (create and next-item)
  * - nanos interface family: deps_api
  *   - 1000: First implementation of dependencies plugins.
  *   - 1001: Commutative clause support.
+ *   - 1002: Task graph capture and replay services.
  * - nanos interface family: openmp
  *   - 1: First Nanos OpenMP interface: nanos_omp_single ( b ) service
  *   - 2: Including nanos_omp_barrier() service
@@ -151,6 +153,7 @@ typedef void * nanos_sched_t;
 typedef void * nanos_slicer_t;
 typedef void * nanos_dd_t;
 typedef void * nanos_sync_cond_t;
+typedef void * nanos_graph_t;
 typedef unsigned int nanos_copy_id_t;
 
 typedef struct nanos_const_wd_definition_tag {
@@ -215,6 +218,11 @@ NANOS_API_DECL(nanos_err_t, nanos_create_sliced_wd, ( nanos_wd_t *uwd, size_t nu
 
 NANOS_API_DECL(nanos_err_t, nanos_submit, ( nanos_wd_t wd, size_t num_data_accesses, nanos_data_access_t *data_accesses, nanos_team_t team ));
 
+NANOS_API_DECL(nanos_err_t, nanos_create_wds_compact, ( size_t num_wds, nanos_wd_t *wds, nanos_const_wd_definition_t *const_data,
+                                                        nanos_wd_dyn_props_t *dyn_props, size_t data_size, void ** data, nanos_wg_t wg,
+                                                        nanos_copy_data_t **copies, nanos_region_dimension_internal_t **dimensions ));
+NANOS_API_DECL(nanos_err_t, nanos_submit_wds, ( size_t num_wds, nanos_wd_t *wds ));
+
 NANOS_API_DECL(nanos_err_t, nanos_create_wd_and_run_compact, ( nanos_const_wd_definition_t *const_data, nanos_wd_dyn_props_t *dyn_props,
                                                                size_t data_size, void * data, size_t num_data_accesses, nanos_data_access_t *data_accesses,
                                                                nanos_copy_data_t *copies, nanos_region_dimension_internal_t *dimensions, nanos_translate_args_t translate_args ));
@@ -284,6 +292,13 @@ NANOS_API_DECL(nanos_err_t, nanos_dependence_release_all, ( void ) );
 NANOS_API_DECL(nanos_err_t, nanos_dependence_pendant_writes, ( bool *res, void *addr ));
 NANOS_API_DECL(nanos_err_t, nanos_dependence_create, ( nanos_wd_t pred, nanos_wd_t succ ) );
 
+/* task graph */
+typedef void (*nanos_graph_update_t) ( unsigned int node, void *data, void *arg );
+NANOS_API_DECL(nanos_err_t, nanos_graph_capture_begin, ( void ) );
+NANOS_API_DECL(nanos_err_t, nanos_graph_capture_end, ( nanos_graph_t *graph ) );
+NANOS_API_DECL(nanos_err_t, nanos_graph_replay, ( nanos_graph_t graph, nanos_graph_update_t update, void *arg ) );
+NANOS_API_DECL(nanos_err_t, nanos_graph_destroy, ( nanos_graph_t graph ) );
+
 /* worksharing */
 NANOS_API_DECL(nanos_err_t, nanos_worksharing_create ,( nanos_ws_desc_t **wsd, nanos_ws_t ws, nanos_ws_info_t *info, bool *b ) );
 NANOS_API_DECL(nanos_err_t, nanos_worksharing_next_item, ( nanos_ws_desc_t *wsd, nanos_ws_item_t *wsi ) );
@@ -25,6 +25,7 @@
 #include "instrumentationmodule_decl.hpp"
 #include "basethread.hpp"
 #include "workdescriptor.hpp"
+#include "taskgraph.hpp"
 
 /*! \defgroup capi_dependence Dependence services.
  *  \ingroup capi
@@ -83,6 +84,85 @@ NANOS_API_DEF(nanos_err_t, nanos_dependence_create, ( nanos_wd_t pred, nanos_wd_
    }
    return NANOS_OK;
 }
+
+/*! \brief Starts capturing the task graph submitted by the current WorkDescriptor
+ *
+ *  Tasks submitted until nanos_graph_capture_end() are recorded along with the dependences found
+ *  among them; they do not start running before the capture ends, so the current WorkDescriptor
+ *  must not wait for them (taskwait, wait on) in between.
+ */
+NANOS_API_DEF(nanos_err_t, nanos_graph_capture_begin, ( void ) )
+{
+   NANOS_INSTRUMENT( InstrumentStateAndBurst inst("api","graph_capture_begin",NANOS_RUNTIME) );
+   try {
+      WD *wd = myThread->getCurrentWD();
+      if ( wd->getCapturedGraph() != NULL ) return NANOS_INVALID_REQUEST;
+      wd->setCapturedGraph( NEW TaskGraph() );
+   } catch ( nanos_err_t e) {
+      return e;
+   }
+   return NANOS_OK;
+}
+
+/*! \brief Finishes the capture started by nanos_graph_capture_begin() and lets the captured tasks run
+ *
+ *  \param [out] graph is the recorded task graph
+ */
+NANOS_API_DEF(nanos_err_t, nanos_graph_capture_end, ( nanos_graph_t *graph ) )
+{
+   NANOS_INSTRUMENT( InstrumentStateAndBurst inst("api","graph_capture_end",NANOS_RUNTIME) );
+   try {
+      WD *wd = myThread->getCurrentWD();
+      TaskGraph *tg = wd->getCapturedGraph();
+      if ( tg == NULL ) return NANOS_INVALID_REQUEST;
+      wd->setCapturedGraph( NULL );
+      tg->endCapture();
+      *graph = ( nanos_graph_t ) tg;
+   } catch ( nanos_err_t e) {
+      return e;
+   }
+   return NANOS_OK;
+}
+
+/*! \brief Submits a new instance of a captured task graph as children of the current WorkDescriptor
+ *
+ *  The dependences among the new tasks are the ones recorded during the capture; no dependence
+ *  with any other task is computed, so the replay must be separated from them by a taskwait.
+ *
+ *  \param [in] graph is the task graph
+ *  \param [in] update is called with the arguments of each new task, in capture order [Optional]
+ *  \param [in] arg is passed to update
+ */
+NANOS_API_DEF(nanos_err_t, nanos_graph_replay, ( nanos_graph_t graph, nanos_graph_update_t update, void *arg ) )
+{
+   NANOS_INSTRUMENT( InstrumentStateAndBurst inst("api","graph_replay",NANOS_RUNTIME) );
+   try {
+      TaskGraph *tg = ( TaskGraph * ) graph;
+      WD *wd = myThread->getCurrentWD();
+      if ( tg == NULL ) return NANOS_INVALID_PARAM;
+      if ( !tg->isReplayable() || wd->getCapturedGraph() != NULL ) return NANOS_INVALID_REQUEST;
+      tg->replay( *wd, update, arg );
+   } catch ( nanos_err_t e) {
+      return e;
+   }
+   return NANOS_OK;
+}
+
+/*! \brief Releases a captured task graph
+ *
+ *  \param [in] graph is the task graph
+ */
+NANOS_API_DEF(nanos_err_t, nanos_graph_destroy, ( nanos_graph_t graph ) )
+{
+   NANOS_INSTRUMENT( InstrumentStateAndBurst inst("api","graph_destroy",NANOS_RUNTIME) );
+   try {
+      delete ( TaskGraph * ) graph;
+   } catch ( nanos_err_t e) {
+      return e;
+   }
+   return NANOS_OK;
+}
+
 /*!
  * \}
  */ 
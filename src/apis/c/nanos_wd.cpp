@@ -175,6 +175,79 @@ NANOS_API_DEF(nanos_err_t, nanos_create_sliced_wd, ( nanos_wd_t *uwd, size_t num
    return NANOS_OK;
 }
 
+/*! \brief Creates several WorkDescriptors sharing the same definition
+ *
+ *  Loops generating many identical tasks pay a single throttle check and
+ *  API call instead of one per task. If the throttle policy refuses to
+ *  create tasks (non mandatory creation), all the entries of wds are set
+ *  to NULL and the caller must execute the work itself.
+ *
+ *  \param num_wds number of WDs to create
+ *  \param wds array of num_wds entries that receives the new WDs
+ *  \param const_data_ext constant definition shared by all the WDs
+ *  \param dyn_props dynamic properties shared by all the WDs
+ *  \param data_size size of the data environment of each WD
+ *  \param data array of num_wds entries that receives the data environment of each WD
+ *  \param uwg if (wg != 0) the new WDs are added to that WD
+ *  \param copies if num_copies > 0, array of num_wds entries that receives the copies of each WD
+ *  \param dimensions if num_copies > 0, array of num_wds entries that receives the dimensions of each WD
+ *  \sa nanos_create_wd_compact, nanos_submit_wds
+ */
+NANOS_API_DEF( nanos_err_t, nanos_create_wds_compact, ( size_t num_wds, nanos_wd_t *wds, nanos_const_wd_definition_t *const_data_ext,
+                                                        nanos_wd_dyn_props_t *dyn_props, size_t data_size, void ** data, nanos_wg_t uwg,
+                                                        nanos_copy_data_t **copies, nanos_region_dimension_internal_t **dimensions ) )
+{
+   NANOS_INSTRUMENT( InstrumentStateAndBurst inst("api","*_create_wd",NANOS_CREATION) );
+
+   nanos_const_wd_definition_internal_t *const_data = reinterpret_cast<nanos_const_wd_definition_internal_t*>(const_data_ext);
+
+   try
+   {
+      if ( !const_data->props.mandatory_creation && !sys.throttleTaskIn() ) {
+         for ( size_t i = 0; i < num_wds; i++ ) wds[i] = 0;
+         return NANOS_OK;
+      }
+      sys.createWDs ( num_wds, (WD **) wds, const_data->num_devices, const_data->devices, data_size, const_data->data_alignment,
+                      data, (WD *) uwg, &const_data->props, dyn_props, const_data->num_copies, copies,
+                      const_data->num_dimensions, dimensions, const_data->description );
+
+   } catch ( nanos_err_t e) {
+      return e;
+   }
+
+   return NANOS_OK;
+}
+
+//! \brief Raises the events that trace the submission of a WD
+static void instrumentSubmit ( WD *wd, size_t num_data_accesses, nanos_data_access_t *data_accesses )
+{
+   NANOS_INSTRUMENT ( static InstrumentationDictionary *ID = sys.getInstrumentation()->getInstrumentationDictionary(); )
+
+   NANOS_INSTRUMENT ( static nanos_event_key_t create_wd_id = ID->getEventKey("create-wd-id"); )
+   NANOS_INSTRUMENT ( static nanos_event_key_t create_wd_ptr = ID->getEventKey("create-wd-ptr"); )
+   NANOS_INSTRUMENT ( static nanos_event_key_t wd_num_deps = ID->getEventKey("wd-num-deps"); )
+   NANOS_INSTRUMENT ( static nanos_event_key_t wd_deps_ptr = ID->getEventKey("wd-deps-ptr"); )
+
+   NANOS_INSTRUMENT ( nanos_event_key_t Keys[4]; )
+   NANOS_INSTRUMENT ( nanos_event_value_t Values[4]; )
+
+   NANOS_INSTRUMENT ( Keys[0] = create_wd_id; )
+   NANOS_INSTRUMENT ( Values[0] = (nanos_event_value_t) wd->getId(); )
+
+   NANOS_INSTRUMENT ( Keys[1] = create_wd_ptr; )
+   NANOS_INSTRUMENT ( Values[1] = (nanos_event_value_t) wd; )
+
+   NANOS_INSTRUMENT ( Keys[2] = wd_num_deps; )
+   NANOS_INSTRUMENT ( Values[2] = (nanos_event_value_t) num_data_accesses; )
+
+   NANOS_INSTRUMENT ( Keys[3] = wd_deps_ptr; );
+   NANOS_INSTRUMENT ( Values[3] = (nanos_event_value_t) data_accesses; )
+
+   NANOS_INSTRUMENT( sys.getInstrumentation()->raisePointEvents(4, Keys, Values); )
+
+   NANOS_INSTRUMENT (sys.getInstrumentation()->raiseOpenPtPEvent ( NANOS_WD_DOMAIN, (nanos_event_id_t) wd->getId(), 0, 0 );)
+}
+
 /*! \brief Submit a WorkDescriptor
  *
  *  \sa nanos::WorkDescriptor
@@ -198,38 +271,44 @@ NANOS_API_DEF(nanos_err_t, nanos_submit, ( nanos_wd_t uwd, size_t num_data_acces
 
       sys.setupWD( *wd, myThread->getCurrentWD() );
 
-      NANOS_INSTRUMENT ( static InstrumentationDictionary *ID = sys.getInstrumentation()->getInstrumentationDictionary(); )
+      instrumentSubmit( wd, num_data_accesses, data_accesses );
 
-      NANOS_INSTRUMENT ( static nanos_event_key_t create_wd_id = ID->getEventKey("create-wd-id"); )
-      NANOS_INSTRUMENT ( static nanos_event_key_t create_wd_ptr = ID->getEventKey("create-wd-ptr"); )
-      NANOS_INSTRUMENT ( static nanos_event_key_t wd_num_deps = ID->getEventKey("wd-num-deps"); )
-      NANOS_INSTRUMENT ( static nanos_event_key_t wd_deps_ptr = ID->getEventKey("wd-deps-ptr"); )
-
-      NANOS_INSTRUMENT ( nanos_event_key_t Keys[4]; )
-      NANOS_INSTRUMENT ( nanos_event_value_t Values[4]; )
-
-      NANOS_INSTRUMENT ( Keys[0] = create_wd_id; )
-      NANOS_INSTRUMENT ( Values[0] = (nanos_event_value_t) wd->getId(); )
-
-      NANOS_INSTRUMENT ( Keys[1] = create_wd_ptr; )
-      NANOS_INSTRUMENT ( Values[1] = (nanos_event_value_t) wd; )
+      if ( num_data_accesses != 0 && data_accesses != NULL ) {
+         sys.submitWithDependencies( *wd, num_data_accesses, data_accesses );
+         return NANOS_OK;
+      }
 
-      NANOS_INSTRUMENT ( Keys[2] = wd_num_deps; )
-      NANOS_INSTRUMENT ( Values[2] = (nanos_event_value_t) num_data_accesses; )
+      sys.submit( *wd );
+   } catch ( nanos_err_t e) {
+      return e;
+   }
 
-      NANOS_INSTRUMENT ( Keys[3] = wd_deps_ptr; );
-      NANOS_INSTRUMENT ( Values[3] = (nanos_event_value_t) data_accesses; )
+   return NANOS_OK;
+}
 
-      NANOS_INSTRUMENT( sys.getInstrumentation()->raisePointEvents(4, Keys, Values); )
+/*! \brief Submit several WorkDescriptors without dependencies
+ *
+ *  The WDs are handed to the scheduler as a single batch.
+ *
+ *  \param num_wds number of WDs to submit
+ *  \param wds array of num_wds WDs, usually created with nanos_create_wds_compact
+ *  \sa nanos_submit, nanos_create_wds_compact
+ */
+NANOS_API_DEF(nanos_err_t, nanos_submit_wds, ( size_t num_wds, nanos_wd_t *wds ))
+{
+   NANOS_INSTRUMENT( InstrumentStateAndBurst inst("api","submit",NANOS_SCHEDULING) );
 
-      NANOS_INSTRUMENT (sys.getInstrumentation()->raiseOpenPtPEvent ( NANOS_WD_DOMAIN, (nanos_event_id_t) wd->getId(), 0, 0 );)
+   try {
+      WD *current = myThread->getCurrentWD();
+      for ( size_t i = 0; i < num_wds; i++ ) {
+         ensure( wds[i],"NULL WD received" );
 
-      if ( num_data_accesses != 0 && data_accesses != NULL ) {
-         sys.submitWithDependencies( *wd, num_data_accesses, data_accesses );
-         return NANOS_OK;
+         WD * wd = ( WD * ) wds[i];
+         sys.setupWD( *wd, current );
+         instrumentSubmit( wd, 0, NULL );
       }
 
-      sys.submit( *wd );
+      sys.submit( (WD **) wds, num_wds );
    } catch ( nanos_err_t e) {
       return e;
    }
@@ -22,7 +22,7 @@
 #include "clusterthread_decl.hpp"
 #include "clusternode_decl.hpp"
 #include "system_decl.hpp"
-#include "workdescriptor_decl.hpp"
+#include "workdescriptor.hpp"
 #include "basethread.hpp"
 #include "smpthread.hpp"
 #include "netwd_decl.hpp"
@@ -63,7 +63,7 @@ void ClusterThread::RunningWDQueue::clearCompletedWDs( ClusterThread *self ) {
    {
       WD *completedWD = _completedWDs[pos];
       Scheduler::postOutlineWork( completedWD, false, self );
-      delete[] (char *) completedWD;
+      WorkDescriptor::freeChunk( completedWD, /* destroy */ false );
       _completedWDs[pos] =(WD *) 0xdeadbeef;
       pos = (pos+1) % MAX_PRESEND;
       lowval += 1;
@@ -131,8 +131,7 @@ class RemoteSpawn {
 							myThread->setCurrentWD(*previousWD);
 
 							// Destroy wd
-							finishedWD->~WorkDescriptor();
-							delete[] (char *)finishedWD;
+							WorkDescriptor::freeChunk( finishedWD );
 						}
 					}
 				}
@@ -24,6 +24,7 @@
 #include "instrumentation.hpp"
 #include "taskexecutionexception.hpp"
 #include "smpdevice.hpp"
+#include "smpstackpool_decl.hpp"
 #include "schedule.hpp"
 #include <string>
 
@@ -50,6 +51,13 @@ void SMPDD::prepareConfig ( Config &config )
    //! \note Get the stack size for this specific device
    config.registerConfigOption ( "smp-stack-size", NEW Config::SizeVar( _stackSize ), "Defines SMP::task stack size" );
    config.registerArgOption("smp-stack-size", "smp-stack-size");
+
+   SMPStackPool::prepareConfig( config );
+}
+
+SMPDD::~SMPDD()
+{
+   if ( _stack ) SMPStackPool::release( _stack, _stackSize );
 }
 
 void SMPDD::initStack ( WD *wd )
@@ -87,8 +95,7 @@ void SMPDD::lazyInit ( WD &wd, bool isUserLevelThread, WD *previous )
    verbose0("Task " << wd.getId() << " initialization"); 
    if (isUserLevelThread) {
       if (previous == NULL) {
-         _stack = (void *) NEW char[_stackSize];
-         verbose0("   new stack created: " << _stackSize << " bytes");
+         _stack = SMPStackPool::allocate( _stackSize );
       } else {
          verbose0("   reusing stacks");
          SMPDD &oldDD = (SMPDD &) previous->getActiveDevice();
@@ -51,7 +51,7 @@ namespace ext {
          //! \brief Assignment operator
          const SMPDD & operator= ( const SMPDD &wd );
          //! \brief Destructor
-         virtual ~SMPDD() { if ( _stack ) delete[] (char *) _stack; }
+         virtual ~SMPDD();
 
          bool hasStack() { return _state != NULL; }
 
@@ -205,6 +205,14 @@ void SMPDevice::tryExecuteTransfer() {
    _transferQueue.tryExecuteOne();
 }
 
+void SMPDevice::startTransferHelpers( unsigned int numHelpers, std::size_t maxPendingBytes ) {
+   _transferQueue.startHelpers( numHelpers, maxPendingBytes );
+}
+
+void SMPDevice::stopTransferHelpers() {
+   _transferQueue.stopHelpers();
+}
+
 } // namespace nanos
 
 #endif
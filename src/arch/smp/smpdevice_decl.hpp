@@ -73,6 +73,13 @@ namespace nanos {
 
          void tryExecuteTransfer();
 
+         /*! \brief Starts threads dedicated to execute the queued transfers
+          *  \see SMPTransferQueue::startHelpers
+          */
+         void startTransferHelpers( unsigned int numHelpers, std::size_t maxPendingBytes );
+
+         void stopTransferHelpers();
+
    };
 } // namespace nanos
 
@@ -68,6 +68,8 @@ nanos::PE * smpProcessorFactory ( int id, int uid )
                  , _memkindSupport( false )
                  , _memkindMemorySize( 1024*1024*1024 ) // 1Gb
                  , _asyncSMPTransfers( true )
+                 , _smpTransferThreads( 0 )
+                 , _smpTransferMaxBytes( 0 )
    {}
 
    SMPPlugin::~SMPPlugin() {
@@ -150,6 +152,16 @@ nanos::PE * smpProcessorFactory ( int id, int uid )
             "SMP sync transfers." );
       cfg.registerArgOption( "smp-sync-transfers", "smp-sync-transfers" );
       cfg.registerEnvOption( "smp-sync-transfers", "NX_SMP_SYNC_TRANSFERS" );
+
+      cfg.registerConfigOption( "smp-transfer-threads", NEW Config::PositiveVar( _smpTransferThreads ),
+            "Number of helper threads executing SMP async transfers while workers compute (default: 0)." );
+      cfg.registerArgOption( "smp-transfer-threads", "smp-transfer-threads" );
+      cfg.registerEnvOption( "smp-transfer-threads", "NX_SMP_TRANSFER_THREADS" );
+
+      cfg.registerConfigOption( "smp-transfer-max-bytes", NEW Config::SizeVar( _smpTransferMaxBytes ),
+            "Bound of the bytes queued for SMP async transfers, 0 means unbounded (default: 0)." );
+      cfg.registerArgOption( "smp-transfer-max-bytes", "smp-transfer-max-bytes" );
+      cfg.registerEnvOption( "smp-transfer-max-bytes", "NX_SMP_TRANSFER_MAX_BYTES" );
    }
 
    void SMPPlugin::init()
@@ -343,6 +355,8 @@ nanos::PE * smpProcessorFactory ( int id, int uid )
    void SMPPlugin::initialize() { }
 
    void SMPPlugin::finalize() {
+      getSMPDevice().stopTransferHelpers();
+
       if ( _memkindSupport ) {
          SeparateMemoryAddressSpace &mem = sys.getSeparateMemory( 1 );
          std::cerr << "memkind: SMP soft replacements: " << mem.getSoftInvalidationCount() << std::endl;
@@ -394,7 +408,11 @@ nanos::PE * smpProcessorFactory ( int id, int uid )
       }
    }
 
-   void SMPPlugin::startSupportThreads() { }
+   void SMPPlugin::startSupportThreads() {
+      if ( _asyncSMPTransfers && ( _smpTransferThreads > 0 || _smpTransferMaxBytes > 0 ) ) {
+         getSMPDevice().startTransferHelpers( _smpTransferThreads, _smpTransferMaxBytes );
+      }
+   }
 
    void SMPPlugin::startWorkerThreads( std::map<unsigned int, BaseThread *> &workers )
    {
@@ -83,6 +83,8 @@ class SMPPlugin : public SMPBasePlugin
    bool                         _memkindSupport;
    std::size_t                  _memkindMemorySize;
    bool                         _asyncSMPTransfers;
+   int                          _smpTransferThreads;
+   std::size_t                  _smpTransferMaxBytes;
 
    public:
    SMPPlugin();
@@ -0,0 +1,97 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "smpstackpool_decl.hpp"
+#include "debug.hpp"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+using namespace nanos;
+using namespace nanos::ext;
+
+__thread SMPStackPool::FreeStack * SMPStackPool::_freeStacks = NULL;
+__thread size_t SMPStackPool::_numFree = 0;
+size_t SMPStackPool::_maxFree = 64;
+size_t SMPStackPool::_trimThreshold = 8;
+size_t SMPStackPool::_pageSize = 0;
+
+void SMPStackPool::prepareConfig ( Config &config )
+{
+   config.registerConfigOption ( "smp-stack-pool", NEW Config::SizeVar( _maxFree ),
+                                 "Defines the number of SMP task stacks cached per thread (default: 64)" );
+   config.registerArgOption( "smp-stack-pool", "smp-stack-pool" );
+   config.registerEnvOption( "smp-stack-pool", "NX_SMP_STACK_POOL" );
+
+   config.registerConfigOption ( "smp-stack-pool-trim", NEW Config::SizeVar( _trimThreshold ),
+                                 "Defines the number of SMP task stacks cached per thread before returning the memory of "
+                                 "the cached stacks to the system (default: 8)" );
+   config.registerArgOption( "smp-stack-pool-trim", "smp-stack-pool-trim" );
+   config.registerEnvOption( "smp-stack-pool-trim", "NX_SMP_STACK_POOL_TRIM" );
+}
+
+size_t SMPStackPool::usableSize ( size_t size )
+{
+   if ( _pageSize == 0 ) _pageSize = sysconf( _SC_PAGESIZE );
+   return ( size + _pageSize - 1 ) & ~( _pageSize - 1 );
+}
+
+void * SMPStackPool::allocate ( size_t size )
+{
+   if ( _freeStacks != NULL ) {
+      FreeStack *stack = _freeStacks;
+      _freeStacks = stack->next;
+      _numFree--;
+      return (void *) stack;
+   }
+
+   size_t usable = usableSize( size );
+   char *map = (char *) mmap( NULL, usable + _pageSize, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+   fatal_cond0( map == MAP_FAILED, "Cannot allocate a " << usable << " bytes task stack: " << strerror( errno ) );
+
+   // The stack grows downwards, the guard page goes below the usable area
+   if ( mprotect( map, _pageSize, PROT_NONE ) != 0 ) {
+      warning0( "Cannot set the guard page of a task stack: " << strerror( errno ) );
+   }
+
+   verbose0( "   new stack created: " << usable << " bytes" );
+   return (void *) ( map + _pageSize );
+}
+
+void SMPStackPool::release ( void *stack, size_t size )
+{
+   size_t usable = usableSize( size );
+
+   if ( _numFree >= _maxFree ) {
+      munmap( (char *) stack - _pageSize, usable + _pageSize );
+      return;
+   }
+
+   if ( _numFree >= _trimThreshold ) {
+      // Keep the mapping, the pages will be committed again on demand
+      madvise( stack, usable, MADV_DONTNEED );
+   }
+
+   FreeStack *link = (FreeStack *) stack;
+   link->next = _freeStacks;
+   _freeStacks = link;
+   _numFree++;
+}
@@ -0,0 +1,69 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_SMP_STACK_POOL_DECL
+#define _NANOS_SMP_STACK_POOL_DECL
+
+#include <stddef.h>
+#include "config.hpp"
+
+namespace nanos {
+namespace ext {
+
+   //! \brief Per-thread cache of user-level thread stacks
+   //!
+   //! Stacks are anonymous mappings, so their pages are only committed when the task touches
+   //! them, with a PROT_NONE guard page below the usable area that turns a stack overflow into
+   //! a segmentation fault. A released stack goes to the cache of the releasing thread. Once
+   //! the cache holds more than the trim threshold, the pages of the stacks entering it are
+   //! returned to the system with madvise(MADV_DONTNEED), and past the cache limit stacks are
+   //! unmapped.
+   class SMPStackPool
+   {
+      private:
+         //! \brief Link of a cached stack, stored at the bottom of its usable area
+         typedef struct FreeStack {
+            FreeStack *next;
+         } FreeStack;
+
+         static __thread FreeStack  *_freeStacks;     //!< Stacks cached by the calling thread
+         static __thread size_t      _numFree;        //!< Number of stacks in _freeStacks
+         static size_t               _maxFree;        //!< Stacks cached per thread before unmapping them
+         static size_t               _trimThreshold;  //!< Stacks cached per thread before releasing their pages
+         static size_t               _pageSize;
+
+         //! \brief Size of the usable area of a stack, rounded up to pages
+         static size_t usableSize ( size_t size );
+
+      public:
+         //! \brief Registers the pool configuration options
+         static void prepareConfig ( Config &config );
+
+         //! \brief Gets a stack with at least size usable bytes
+         //! \return the lowest address of the usable area
+         static void * allocate ( size_t size );
+
+         //! \brief Returns a stack obtained with allocate ( size )
+         static void release ( void *stack, size_t size );
+   };
+
+} // namespace ext
+} // namespace nanos
+
+#endif
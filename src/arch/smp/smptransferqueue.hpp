@@ -37,12 +37,14 @@ void SMPTransfer::execute() {
    NANOS_INSTRUMENT ( static InstrumentationDictionary *ID = sys.getInstrumentation()->getInstrumentationDictionary(); )
    NANOS_INSTRUMENT ( static nanos_event_key_t key_in = ID->getEventKey("cache-copy-in"); )
    NANOS_INSTRUMENT ( static nanos_event_key_t key_out = ID->getEventKey("cache-copy-out"); )
-   NANOS_INSTRUMENT( sys.getInstrumentation()->raiseOpenBurstEvent( _in ? key_in : key_out , (nanos_event_value_t) _count * _len ); )
+   // Helper threads are not runtime threads: they have neither instrumentation context nor log file
+   bool runtimeThread = ( myThread != NULL );
+   NANOS_INSTRUMENT( if ( runtimeThread ) sys.getInstrumentation()->raiseOpenBurstEvent( _in ? key_in : key_out , (nanos_event_value_t) _count * _len ); )
    for ( std::size_t count = 0; count < _count; count += 1) {
       //if ( sys.getVerboseDevOps()){ 
       //   std::cerr << "memcpy( " << (void*)(_dst + count) << ", " << (void*)(_src + count *_ld) << ", " << _len << " ) [ld= " << _ld << " count= " << _count << " _dst= " << (void*)_dst << " _src= " << (void*)_src << " ]" << std::endl;
       //}
-      if (sys._watchAddr != NULL ) {
+      if (sys._watchAddr != NULL && runtimeThread ) {
          if ((uint64_t )sys._watchAddr >= (uint64_t)(_dst + count *_ld ) && (uint64_t )sys._watchAddr < (uint64_t)(_dst + count *_ld + _len)) {
             char buff[256];
             snprintf(buff, 256, "WATCH update: old value %a", *((double *) sys._watchAddr ) );
@@ -55,7 +57,7 @@ void SMPTransfer::execute() {
          }
       }
       ::memcpy( _dst + count * _ld, _src + count * _ld, _len );
-      if (sys._watchAddr != NULL ) {
+      if (sys._watchAddr != NULL && runtimeThread ) {
          if ((uint64_t )sys._watchAddr >= (uint64_t)(_dst + count *_ld ) && (uint64_t )sys._watchAddr < (uint64_t)(_dst + count * _ld + _len)) {
             char buff[256];
             snprintf(buff, 256, "WATCH update: new value %a", *((double *) sys._watchAddr ) );
@@ -65,12 +67,25 @@ void SMPTransfer::execute() {
    }
    //*myThread->_file << "Execueted op " << (void *) _dst  << " ops: " << (void *) _ops << " is in " << _in << " content (dst): [" << ((double *)_dst)[0] << " " << ((double *)_dst)[1] << "]" << std::endl; 
    _ops->completeOp();
-   NANOS_INSTRUMENT( sys.getInstrumentation()->raiseCloseBurstEvent( _in ? key_in : key_out, (nanos_event_value_t) 0 ); )
+   NANOS_INSTRUMENT( if ( runtimeThread ) sys.getInstrumentation()->raiseCloseBurstEvent( _in ? key_in : key_out, (nanos_event_value_t) 0 ); )
+}
+
+std::size_t SMPTransfer::getSize() const {
+   return _len * _count;
 }
 
 #define CHUNK_SIZE 4096
 
-SMPTransferQueue::SMPTransferQueue() : _lock(), _transfers() {}
+SMPTransferQueue::SMPTransferQueue() : _lock(), _transfers(), _pendingBytes( 0 ), _maxPendingBytes( 0 ), _helpers(), _stopHelpers( false ) {
+   pthread_mutex_init( &_helpersMutex, NULL );
+   pthread_cond_init( &_helpersCond, NULL );
+}
+
+SMPTransferQueue::~SMPTransferQueue() {
+   stopHelpers();
+   pthread_cond_destroy( &_helpersCond );
+   pthread_mutex_destroy( &_helpersMutex );
+}
 void SMPTransferQueue::addTransfer( DeviceOps *ops, char *dst, char *src, std::size_t len, std::size_t count, std::size_t ld, bool in ) {
    _lock.acquire();
    // NANOS_INSTRUMENT ( static InstrumentationDictionary *ID = sys.getInstrumentation()->getInstrumentationDictionary(); )
@@ -110,13 +125,21 @@ void SMPTransferQueue::addTransfer( DeviceOps *ops, char *dst, char *src, std::s
       _transfers.push_back( SMPTransfer(ops, dst, src, len, count, ld, in) );
    }
    // NANOS_INSTRUMENT( sys.getInstrumentation()->raiseCloseBurstEvent( key, (nanos_event_value_t) 0 ); )
+   _pendingBytes += len * count;
    _lock.release();
+
+   if ( !_helpers.empty() ) wakeUpHelpers();
+
+   // Too many bytes in flight: help draining the queue instead of queueing more
+   if ( _maxPendingBytes > 0 ) {
+      while ( _pendingBytes.value() > _maxPendingBytes && tryExecuteOne() ) {}
+   }
 }
-void SMPTransferQueue::tryExecuteOne() {
+bool SMPTransferQueue::tryExecuteOne() {
+   bool found = false;
    if ( !_transfers.empty() ) {
       if ( true /*_lock.tryAcquire()*/ ) {
          _lock.acquire();
-         bool found = false;
          SMPTransfer t;
          if ( !_transfers.empty() ) {
             found = true;
@@ -124,10 +147,62 @@ void SMPTransferQueue::tryExecuteOne() {
             _transfers.pop_front();
          }
          _lock.release();
-         if ( found ) 
+         if ( found ) {
             t.execute();
+            _pendingBytes -= t.getSize();
+         }
+      }
+   }
+   return found;
+}
+
+void SMPTransferQueue::wakeUpHelpers() {
+   pthread_mutex_lock( &_helpersMutex );
+   pthread_cond_signal( &_helpersCond );
+   pthread_mutex_unlock( &_helpersMutex );
+}
+
+void *SMPTransferQueue::helperLoop( void *queue ) {
+   SMPTransferQueue &q = *( SMPTransferQueue * ) queue;
+   for (;;) {
+      if ( q.tryExecuteOne() ) continue;
+
+      pthread_mutex_lock( &q._helpersMutex );
+      // Transfers are added before helpers are signaled, so checking under the mutex does not miss wake ups
+      while ( q._transfers.empty() && !q._stopHelpers ) {
+         pthread_cond_wait( &q._helpersCond, &q._helpersMutex );
       }
+      bool stop = q._transfers.empty() && q._stopHelpers;
+      pthread_mutex_unlock( &q._helpersMutex );
+
+      if ( stop ) break;
+   }
+   return NULL;
+}
+
+void SMPTransferQueue::startHelpers( unsigned int numHelpers, std::size_t maxPendingBytes ) {
+   _maxPendingBytes = maxPendingBytes;
+   _stopHelpers = false;
+   _helpers.resize( numHelpers );
+   for ( unsigned int i = 0; i < numHelpers; i++ ) {
+      if ( pthread_create( &_helpers[i], NULL, helperLoop, this ) ) {
+         fatal( "couldn't create SMP transfer helper thread" );
+      }
+   }
+}
+
+void SMPTransferQueue::stopHelpers() {
+   if ( _helpers.empty() ) return;
+
+   pthread_mutex_lock( &_helpersMutex );
+   _stopHelpers = true;
+   pthread_cond_broadcast( &_helpersCond );
+   pthread_mutex_unlock( &_helpersMutex );
+
+   for ( std::vector< pthread_t >::iterator it = _helpers.begin(); it != _helpers.end(); it++ ) {
+      pthread_join( *it, NULL );
    }
+   _helpers.clear();
 }
 
 } // namespace nanos
@@ -2,6 +2,8 @@
 #define SMPTRANSFERQUEUE_DECL
 
 #include <list>
+#include <vector>
+#include <pthread.h>
 #include "atomic_decl.hpp"
 #include "deviceops_fwd.hpp"
 
@@ -22,15 +24,43 @@ class SMPTransfer {
    SMPTransfer &operator=( SMPTransfer const &s );
    ~SMPTransfer();
    void execute();
+   std::size_t getSize() const;
 };
 
+/*! \brief Queue of pending SMP copies
+ *
+ *  Copies are executed by idle worker threads and, when started, by a set of
+ *  helper threads that drain the queue while the workers compute. The amount of
+ *  queued bytes can be bounded: a thread adding a transfer over the limit
+ *  executes queued transfers itself until the queue is back under it.
+ */
 class SMPTransferQueue {
    Lock _lock;
    std::list< SMPTransfer > _transfers;
+   Atomic<std::size_t> _pendingBytes;       /*!< bytes of the queued transfers */
+   std::size_t _maxPendingBytes;            /*!< bound of _pendingBytes, 0 means unbounded */
+   std::vector< pthread_t > _helpers;
+   pthread_mutex_t _helpersMutex;
+   pthread_cond_t _helpersCond;
+   volatile bool _stopHelpers;
+
+   static void *helperLoop( void *queue );
+   void wakeUpHelpers();
+
    public:
    SMPTransferQueue();
+   ~SMPTransferQueue();
    void addTransfer( DeviceOps *ops, char *dst, char *src, std::size_t len, std::size_t count, std::size_t ld, bool in );
-   void tryExecuteOne();
+   bool tryExecuteOne();
+
+   /*! \brief Starts the helper threads and sets the bound of queued bytes
+    *  \param numHelpers number of threads dedicated to execute transfers
+    *  \param maxPendingBytes bound of queued bytes, 0 means unbounded
+    */
+   void startHelpers( unsigned int numHelpers, std::size_t maxPendingBytes );
+
+   /*! \brief Stops the helper threads once the queue is empty */
+   void stopHelpers();
 };
 
 } // namespace nanos
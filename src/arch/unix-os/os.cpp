@@ -23,6 +23,11 @@
 #include <unistd.h>
 #include <string.h>
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
 #ifdef IS_BGQ_MACHINE
 #include <spi/include/kernel/location.h>
 #include <spi/include/kernel/process.h>
@@ -197,3 +202,25 @@ int OS::nanosleep ( unsigned long long nanoseconds )
    req.tv_nsec = (long) ( nanoseconds % 1000000000ULL );
    return ::nanosleep( &req, &rem );
 }
+
+int OS::futexWait ( int *addr, int val, unsigned long long nanoseconds )
+{
+#ifdef __linux__
+   struct timespec timeout;
+   timeout.tv_sec = (time_t) ( nanoseconds / 1000000000ULL );
+   timeout.tv_nsec = (long) ( nanoseconds % 1000000000ULL );
+   return syscall( SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, &timeout, NULL, 0 );
+#else
+   if ( *addr != val ) return 0;
+   return OS::nanosleep( nanoseconds );
+#endif
+}
+
+int OS::futexWake ( int *addr, int num )
+{
+#ifdef __linux__
+   return syscall( SYS_futex, addr, FUTEX_WAKE_PRIVATE, num, NULL, NULL, 0 );
+#else
+   return 0;
+#endif
+}
@@ -107,6 +107,15 @@ namespace nanos {
 
          static int nanosleep ( unsigned long long nanoseconds );
 
+         /*! \brief Sleeps while *addr == val, at most the given nanoseconds
+          *  \note Falls back to a plain sleep where futexes are not available
+          */
+         static int futexWait ( int *addr, int val, unsigned long long nanoseconds );
+
+         /*! \brief Wakes up to num threads waiting on addr
+          */
+         static int futexWake ( int *addr, int num );
+
          static const InitList & getInitializationFunctions ();
          static const InitList & getPostInitializationFunctions ();
          static const ModuleList & getRequestedModules ();
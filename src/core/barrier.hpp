@@ -31,6 +31,17 @@ inline void Barrier::computeVectorReductions( void )
    myThread->getTeam()->cleanUpReductionList();
 }
 
+inline void Barrier::combineVectorReductions( int target, int source )
+{
+   myThread->getTeam()->combineVectorReductions( target, source );
+}
+
+inline void Barrier::finishVectorReductions( void )
+{
+   myThread->getTeam()->finishVectorReductions();
+   myThread->getTeam()->cleanUpReductionList();
+}
+
 } // namespace nanos
 
 #endif
@@ -55,6 +55,14 @@ namespace nanos {
         /*! \brief Compute team associated reductions
          */
          virtual void computeVectorReductions ( void );
+        /*! \brief Fold the private reduction copies of participant source into the ones of target
+         *
+         *  Lets tree-shaped barriers combine team reductions while gathering the participants
+         */
+         void combineVectorReductions ( int target, int source );
+        /*! \brief Compute team reductions already folded into participant 0
+         */
+         void finishVectorReductions ( void );
    };
 
    typedef Barrier * ( *barrFactory ) ();
@@ -56,6 +56,10 @@ void BaseThread::addNextWD ( WD *next )
    if ( next != NULL ) {
       debug("Add next WD as: " << next << ":"<< next->getId() << " @ thread " << _id );
       _nextWDs.push_back( next );
+
+      // Warm up our cache with the data of the next WD while the current one finishes
+      size_t prefetch = sys.getSchedulerConf().getPrefetchData();
+      if ( prefetch > 0 && this == myThread ) next->prefetchCopies( prefetch );
    }
 
    sys.getThreadManager()->unblockThread(this);
@@ -79,6 +83,7 @@ void BaseThread::associate ( WD *wd )
    _status.has_started = true;
 
    myThread = this;
+   ShardedCounter::setThreadShard( getId() );
    setCurrentWD( *current );
 
    if ( sys.getSMPPlugin()->getBinding() ) bind();
@@ -21,7 +21,7 @@
 #include "instrumentation.hpp"
 #include "system.hpp"
 #include "basethread.hpp"
-#include <alloca.h>
+#include "schedule.hpp"
 
 using namespace nanos;
 
@@ -54,40 +54,27 @@ void DependableObject::finished ( )
          }
       }
 
-      DependableObject::DependableObjectVector &succ = depObj.getSuccessors();
-
-      //*(myThread->_file) << "Successors for wd " << this->getWD()->getId() << " : " << ( this->getWD()->getDescription() != NULL ? this->getWD()->getDescription() : "[no description]" ) << " { " ;
-      //for ( DependableObject::DependableObjectVector::iterator it = succ.begin(); it != succ.end(); it++ ) {
-      //   WD *wd = (*it)->getWD();
-      //   if ( wd != NULL ) {
-      //      *(myThread->_file) << "[" << wd->getId() << " : "<< ( wd->getDescription() != NULL ? wd->getDescription() : "[no description]" ) << " ]";
-      //   } else {
-      //      *(myThread->_file) << "[null succ]";
-      //   }
-      //}
-      //*(myThread->_file) << " }" << std::endl;
+      SuccessorList &succ = depObj.getSuccessors();
 
       // See if it's worth batch releasing.
-      // The idea here is to prevent initialising the vector unless we will
-      // use it.
       if ( succ.size() > 1 )
       {
-         // Construct list of successors to be released immediately.
-         // Allocate as many elements as we have in the successor list
-         WD** immediateSucc = (WD**) alloca( sizeof(WD*) * succ.size() );
-         WD** pIS = immediateSucc;
+         // Successors released immediately are handed to the scheduler in blocks, so
+         // the buffer does not grow with the number of successors
+         WD* immediateSucc[NANOS_SUCC_RELEASE_BATCH];
+         size_t numImmediate = 0;
          
-         for ( DependableObject::DependableObjectVector::iterator it = succ.begin(); it != succ.end(); it++ ) {
-            NANOS_INSTRUMENT ( instrument ( *(it->second) ); ) 
+         for ( SuccessorList::iterator it = succ.begin(); it != succ.end(); it++ ) {
+            NANOS_INSTRUMENT ( instrument ( **it ); ) 
             // If this dependable object can't be released in batch
-            if ( !it->second->canBeBatchReleased() )
+            if ( !(*it)->canBeBatchReleased() )
             {
-               it->second->decreasePredecessors( NULL, this, false, false );
+               (*it)->decreasePredecessors( NULL, this, false, false );
                continue;
             }
             
             // Release this Dependable Object without triggering submission
-            DependableObject& dSucc = *it->second;
+            DependableObject& dSucc = **it;
             // Decrease predecessors
             int numPred = dSucc.decreasePredecessors( NULL, this, true, false );
             
@@ -105,12 +92,16 @@ void DependableObject::finished ( )
                wd->predecessorFinished( this->getWD() );
             }
             
-            *pIS++ = wd ;
+            immediateSucc[numImmediate++] = wd;
+
+            // Batch submit and counter decrement
+            if ( numImmediate == NANOS_SUCC_RELEASE_BATCH ) {
+               DependenciesDomain::decreaseTasksInGraph( numImmediate );
+               Scheduler::submit( immediateSucc, numImmediate );
+               numImmediate = 0;
+            }
          }
 
-         size_t numImmediate = pIS - immediateSucc;
-      
-         // Batch submit and counter decrement
          if ( numImmediate > 0 ){
             DependenciesDomain::decreaseTasksInGraph( numImmediate );
             Scheduler::submit( immediateSucc, numImmediate );
@@ -118,9 +109,9 @@ void DependableObject::finished ( )
       }
       else 
       {
-         for ( DependableObject::DependableObjectVector::iterator it = succ.begin(); it != succ.end(); it++ ) {
-            NANOS_INSTRUMENT ( instrument ( *it->second ); )
-            it->second->decreasePredecessors( NULL, this, false, false );
+         for ( SuccessorList::iterator it = succ.begin(); it != succ.end(); it++ ) {
+            NANOS_INSTRUMENT ( instrument ( **it ); )
+            (*it)->decreasePredecessors( NULL, this, false, false );
          }
       }
    }
@@ -129,7 +120,7 @@ void DependableObject::finished ( )
 void DependableObject::releaseReadDependencies ()
 {
    DependableObject& depObj = *this;
-   DependableObject::DependableObjectVector &succ = depObj.getSuccessors();
+   SuccessorList &succ = depObj.getSuccessors();
 
    // This step guarantees that any Object that wants to add depObj as a successor has done it
    // before we continue or, alternatively, won't do it.
@@ -148,9 +139,9 @@ void DependableObject::releaseReadDependencies ()
 
    //Decrease predecessor for sucessor tasks
    //Only decrease if they are NOT writing or reading something that we write
-   for ( DependableObject::DependableObjectVector::iterator currSucessorIt = succ.begin(); currSucessorIt != succ.end(); ) {
-      DependableObject::TargetVector const &sucessorWrites = currSucessorIt->second->getWrittenTargets();
-      DependableObject::TargetVector const &sucessorReads = currSucessorIt->second->getReadTargets();
+   for ( SuccessorList::iterator currSucessorIt = succ.begin(); currSucessorIt != succ.end(); ) {
+      DependableObject::TargetVector const &sucessorWrites = (*currSucessorIt)->getWrittenTargets();
+      DependableObject::TargetVector const &sucessorReads = (*currSucessorIt)->getReadTargets();
       bool canRemovePredecessor=true;
       for ( DependableObject::TargetVector::const_iterator itCurrWrites = writes.begin(); itCurrWrites != writes.end() && canRemovePredecessor; itCurrWrites++ ) {
          BaseDependency const & currWrite = *(*itCurrWrites);
@@ -168,8 +159,8 @@ void DependableObject::releaseReadDependencies ()
       }
       if (canRemovePredecessor) {
          //DependenciesDomain::decreaseTasksInGraph();
-         NANOS_INSTRUMENT ( instrument ( *currSucessorIt->second ); ) 
-         currSucessorIt->second->decreasePredecessors( NULL, this, false, false );
+         NANOS_INSTRUMENT ( instrument ( **currSucessorIt ); ) 
+         (*currSucessorIt)->decreasePredecessors( NULL, this, false, false );
          succ.erase(currSucessorIt++);
       }
       else 
@@ -189,22 +180,21 @@ DependableObject * DependableObject::releaseImmediateSuccessor ( DependableObjec
 {
    DependableObject * found = NULL;
 
-   DependableObject::DependableObjectVector &succ = getSuccessors();
-   DependableObject::DependableObjectVector incorrectlyErased;
+   SuccessorList &succ = getSuccessors();
+   SuccessorList incorrectlyErased;
 
    {
       SyncLockBlock lock( this->getLock() );
       // NOTE: it gets incremented in the erase
-      for ( DependableObject::DependableObjectVector::iterator it = succ.begin(); it != succ.end(); ) {
+      for ( SuccessorList::iterator it = succ.begin(); it != succ.end(); ) {
          // Is this an immediate successor? 
-         if ( it->second->numPredecessors() == 1 && condition(*it->second) && !(it->second->waits()) ) {
-            if (it->second->isSubmitted()) {
+         if ( (*it)->numPredecessors() == 1 && condition(**it) && !((*it)->waits()) ) {
+            if ((*it)->isSubmitted()) {
                // remove it
-               found = it->second;
-               unsigned int wdId = it->first;
+               found = *it;
                succ.erase(it++);
                if ( found->numPredecessors() != 1 ) {
-                  incorrectlyErased.insert( std::make_pair( wdId, found ) );
+                  incorrectlyErased.insert( found );
                   found = NULL;
                } else {
                   NANOS_INSTRUMENT ( instrument ( *found ); )
@@ -219,7 +209,7 @@ DependableObject * DependableObject::releaseImmediateSuccessor ( DependableObjec
                      // because someone else will do it
                      // Keep the dependency to signal when the WD can actually be run respecting dependencies
                      found->disableSubmission();
-                     succ.insert( std::make_pair( wdId, found ) );
+                     succ.insert( found );
                   } else {
                      // We have removed the successor, so we need to decrease its predecessors
                      found->decreasePredecessors( NULL, this, true, false );
@@ -240,7 +230,7 @@ DependableObject * DependableObject::releaseImmediateSuccessor ( DependableObjec
             it++;
          }
       }
-      for ( DependableObject::DependableObjectVector::iterator it = incorrectlyErased.begin(); it != incorrectlyErased.end(); it++) {
+      for ( SuccessorList::iterator it = incorrectlyErased.begin(); it != incorrectlyErased.end(); it++) {
          succ.insert(*it);
       }
    }
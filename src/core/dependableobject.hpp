@@ -33,6 +33,7 @@
 #include "system_decl.hpp"
 
 #include "dataaccess.hpp"
+#include "successorlist.hpp"
 #include "functors.hpp"
 
 namespace nanos {
@@ -173,7 +174,7 @@ inline DependableObject::DependableObjectVector & DependableObject::getPredecess
    return _predecessors;
 }
 
-inline DependableObject::DependableObjectVector & DependableObject::getSuccessors ( )
+inline SuccessorList & DependableObject::getSuccessors ( )
 {
    return _successors;
 }
@@ -223,12 +224,12 @@ inline bool DependableObject::addSuccessor ( DependableObject &depObj )
 
    sys.getDefaultSchedulePolicy()->atSuccessor( depObj, *this );
 
-   return _successors.insert ( std::make_pair( depObj.getWD() == NULL ? 0 : depObj.getWD()->getId(), &depObj ) ).second;
+   return _successors.insert( &depObj );
 }
 
 inline bool DependableObject::deleteSuccessor ( DependableObject *depObj )
 {
-   return _successors.erase( std::make_pair( depObj->getWD() == NULL ? 0 : depObj->getWD()->getId(), depObj ) ) > 0;
+   return _successors.erase( depObj ) > 0;
 }
 
 inline bool DependableObject::deleteSuccessor ( DependableObject &depObj )
@@ -33,6 +33,7 @@
 #include "workdescriptor_fwd.hpp"
 
 #include "dataaccess_decl.hpp"
+#include "successorlist_decl.hpp"
 
 namespace nanos {
 
@@ -87,7 +88,7 @@ namespace nanos {
    {
       public:
          typedef std::pair< unsigned int, DependableObject * > DependableObjectVectorKey;
-         typedef std::set<DependableObjectVectorKey> DependableObjectVector; /**< Type vector of successors  */
+         typedef std::set<DependableObjectVectorKey> DependableObjectVector; /**< Type vector of predecessors  */
          typedef std::vector<BaseDependency*> TargetVector; /**< Type vector of output objects */
          
       private:
@@ -95,7 +96,7 @@ namespace nanos {
          Atomic<unsigned int>     _numPredecessors; /**< Number of predecessors locking this object */
          unsigned int             _references;      /** References counter */
          DependableObjectVector   _predecessors;    /**< List of predecessors */
-         DependableObjectVector   _successors;      /**< List of successors */
+         SuccessorList            _successors;      /**< List of successors */
          DependenciesDomain      *_domain;          /**< DependenciesDomain where this is located */
          TargetVector             _outputObjects;   /**< List of output objects */
          TargetVector             _readObjects;     /**< List of read objects */
@@ -216,7 +217,7 @@ namespace nanos {
         /*! \brief Obtain the list of successors
          *  \return List of DependableObject* that depend on "this"
          */
-         DependableObjectVector & getSuccessors ( );
+         SuccessorList & getSuccessors ( );
 
          /*! \brief Add a predecessor to the predecessors list
           *  \param depObj DependableObject to be added.
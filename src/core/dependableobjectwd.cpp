@@ -44,7 +44,7 @@ void DOSubmit::dependenciesSatisfiedNoSubmit( )
 
 bool DOSubmit::canBeBatchReleased ( ) const
 {
-   return numPredecessors() == 1 && sys.getDefaultSchedulePolicy()->isValidForBatch( getWD() ) && needsSubmission();
+   return numPredecessors() == 1 && getWD()->getSlicer() == NULL && sys.getDefaultSchedulePolicy()->isValidForBatch( getWD() ) && needsSubmission();
 }
 
 unsigned long DOSubmit::getDescription ( )
@@ -58,9 +58,9 @@ void DOSubmit::instrument ( DependableObject &successor )
    NANOS_INSTRUMENT ( void * succ = successor.getRelatedObject(); )
    NANOS_INSTRUMENT (
                       if ( succ == NULL ) {
-                         DependableObject::DependableObjectVector &succ2 = successor.getSuccessors();
-                         for ( DependableObject::DependableObjectVector::iterator it = succ2.begin(); it != succ2.end(); it++ ) {
-                            instrument ( *(it->second) ); 
+                         SuccessorList &succ2 = successor.getSuccessors();
+                         for ( SuccessorList::iterator it = succ2.begin(); it != succ2.end(); it++ ) {
+                            instrument ( **it ); 
                          }
                          return;
                       }
@@ -114,9 +114,9 @@ void DOWait::instrument ( DependableObject &successor )
    NANOS_INSTRUMENT ( void * succ = successor.getRelatedObject(); )
    NANOS_INSTRUMENT (
                       if ( succ == NULL ) {
-                         DependableObject::DependableObjectVector &succ2 = successor.getSuccessors();
-                         for ( DependableObject::DependableObjectVector::iterator it = succ2.begin(); it != succ2.end(); it++ ) {
-                            instrument ( *(it->second) ); 
+                         SuccessorList &succ2 = successor.getSuccessors();
+                         for ( SuccessorList::iterator it = succ2.begin(); it != succ2.end(); it++ ) {
+                            instrument ( **it ); 
                          }
                          return;
                       }
@@ -439,6 +439,10 @@ namespace nanos {
             registerEventValue("api","in_final","nanos_in_final()");
             registerEventValue("api","set_final","nanos_set_final()");
             registerEventValue("api","dependence_release_all","nanos_dependence_release_all()");
+            registerEventValue("api","graph_capture_begin","nanos_graph_capture_begin()");
+            registerEventValue("api","graph_capture_end","nanos_graph_capture_end()");
+            registerEventValue("api","graph_replay","nanos_graph_replay()");
+            registerEventValue("api","graph_destroy","nanos_graph_destroy()");
             registerEventValue("api","set_translate_function","nanos_set_translate_function()");
             registerEventValue("api","memalign","nanos_memalign()");
             registerEventValue("api","cmalloc","nanos_cmalloc()");
@@ -674,6 +678,7 @@ namespace nanos {
             /* 70 */ registerEventKey("network-transfer", "Network transfer to node ", false, EVENT_ADVANCED);
             /* 71 */ registerEventKey("cache-evict", "Cache eviction", false, EVENT_ADVANCED);
             /* 72 */ registerEventKey("copy-data-alloc","Cache allocation", false, EVENT_ADVANCED);
+            /* 73 */ registerEventKey("steal-remote","WD stolen from another NUMA node (value is node + 1)", true, EVENT_DEVELOPER );
 
             /* ** */ registerEventKey("debug","Debug Key", true, EVENT_ADVANCED ); /* Keep this key as the last one */
          }
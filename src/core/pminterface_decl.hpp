@@ -62,7 +62,7 @@ namespace nanos {
          virtual void wdFinished( nanos::WD &wd ) {}
 
          virtual nanos::ThreadTeamData* getThreadTeamData() { return NEW nanos::ThreadTeamData(); }
-         std::string getDescription( void ) { return _description; }
+         const std::string & getDescription( void ) const { return _description; }
 
          bool isMalleable( void ) const { return _malleable; }
          bool isOmpSs( void ) const { return _malleable; }
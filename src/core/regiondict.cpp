@@ -17,6 +17,7 @@
 /*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
 /*************************************************************************************/
 
+#include <algorithm>
 #include "regiondict.hpp"
 #include "memorymap.hpp"
 #include "atomic.hpp"
@@ -33,16 +34,16 @@ reg_t RegionNode::addNode( nanos_region_dimension_internal_t const *dimensions,
    std::size_t value = ( ( deep & 1 ) == 0 ) ? dimensions[ (deep >> 1) ].lower_bound : dimensions[ (deep >> 1) ].accessed_length;
    //std::cerr << "this node value is "<< _value << " gonna add value " << value << " this deep " << deep<< std::endl;
    if ( !_sons ) {
-      _sons = new std::map<std::size_t, RegionNode *>();
+      _sons = new SonList();
    }
 
-   std::map<std::size_t, RegionNode *>::iterator it = _sons->lower_bound( value );
-   bool haveToInsert = ( it == _sons->end() || _sons->key_comp()(value, it->first) );
+   SonList::iterator it = std::lower_bound( _sons->begin(), _sons->end(), value, SonValueLess() );
+   bool haveToInsert = ( it == _sons->end() || value < it->first );
    reg_t newId = ( lastNode && haveToInsert ) ? container.getNewRegionId() : 0;
    reg_t retId = 0;
 
    if ( haveToInsert ) {
-      it = _sons->insert( it, std::map<std::size_t, RegionNode *>::value_type( value, NEW RegionNode( this, value, newId ) ) );
+      it = _sons->insert( it, Son( value, NEW RegionNode( this, value, newId ) ) );
       if ( lastNode ) container.addRegionNode( it->second );
    }
 
@@ -62,8 +63,8 @@ reg_t RegionNode::checkNode( nanos_region_dimension_internal_t const *dimensions
       return 0;
    }
 
-   std::map<std::size_t, RegionNode *>::iterator it = _sons->lower_bound( value );
-   bool haveToInsert = ( it == _sons->end() || _sons->key_comp()(value, it->first) );
+   SonList::const_iterator it = std::lower_bound( _sons->begin(), _sons->end(), value, SonValueLess() );
+   bool haveToInsert = ( it == _sons->end() || value < it->first );
    reg_t retId = 0;
 
    if ( haveToInsert ) {
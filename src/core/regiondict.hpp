@@ -87,7 +87,7 @@ inline RegionNode &RegionNode::operator=( RegionNode const& rn ) {
 
 inline RegionNode::~RegionNode() {
    if ( _sons != NULL ) {
-      for (std::map<std::size_t, RegionNode *>::const_iterator it = _sons->begin();
+      for ( SonList::const_iterator it = _sons->begin();
             it != _sons->end(); it++ ) {
          delete it->second;
       }
@@ -221,12 +221,17 @@ unsigned int ContainerDense< T >::getNumDimensions() const {
 
 template <class T>
 reg_t ContainerDense< T >::addRegion( nanos_region_dimension_internal_t const region[] ) {
+   // Most registrations find an already known region: look it up sharing the
+   // lock, and only take it exclusively when the region has to be inserted
+   reg_t id = checkIfRegionExists( region );
+   if ( id != 0 ) return id;
+
    if ( pthread_rwlock_wrlock(&_containerLock) ) {
       message0("lock error " );
       fatal("can not continue");
    }
 
-   reg_t id = _root.addNode( region, _dimensionSizes.size(), 0, *this );
+   id = _root.addNode( region, _dimensionSizes.size(), 0, *this );
 
    if ( pthread_rwlock_unlock(&_containerLock) ) {
       message0("lock error " );
@@ -248,7 +253,7 @@ reg_t ContainerDense< T >::getNewRegionId() {
 
 template <class T>
 reg_t ContainerDense< T >::checkIfRegionExists( nanos_region_dimension_internal_t const region[] ) {
-   bool result;
+   reg_t result;
    if ( pthread_rwlock_rdlock(&_containerLock) ) {
       message0("lock error ");
       fatal("can not continue");
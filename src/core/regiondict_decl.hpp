@@ -43,10 +43,19 @@ namespace nanos {
    class RegionVectorEntry;
 
    class RegionNode {
+      //! Sons are kept in a vector sorted by value: lookups are binary searches over
+      //! contiguous memory instead of walks through the nodes of a map.
+      typedef std::pair< std::size_t, RegionNode * > Son;
+      typedef std::vector< Son > SonList;
+
+      struct SonValueLess {
+         bool operator()( Son const &son, std::size_t value ) const { return son.first < value; }
+      };
+
       RegionNode  *_parent;
       std::size_t  _value;
       reg_t _id;
-      std::map<std::size_t, RegionNode *> *_sons;
+      SonList *_sons;
       reg_t *_memoIntersectInfo;
 
       public:
@@ -50,6 +50,10 @@ void SchedulerConf::config (Config &cfg)
 
    cfg.registerConfigOption ( "hold-tasks", NEW Config::FlagOption( _holdTasks ), "Do not submit tasks until a taskwait is reached." );
    cfg.registerArgOption ( "hold-tasks", "hold-tasks" );
+
+   cfg.registerConfigOption ( "prefetch-data", NEW Config::SizeVar( _prefetchData ),
+         "Prefetch up to this many bytes of the copies of a WD when it becomes the next WD of the running thread (default = 0, disabled)" );
+   cfg.registerArgOption ( "prefetch-data", "prefetch-data" );
 }
 
 void Scheduler::submit ( WD &wd, bool force_queue )
@@ -100,6 +104,7 @@ void Scheduler::_submit ( WD &wd, bool force_queue )
       * it in our scheduler system. Global ready task queue will take care about task/thread
       * architecture, while local ready task queue will wait until stealing. */
       mythread->getTeam()->getSchedulePolicy().queue( mythread, wd );
+      thread_manager->wakeUpParked();
 
       return;
    }
@@ -129,6 +134,9 @@ void Scheduler::_submit ( WD &wd, bool force_queue )
 
       }
       switchTo ( slice );
+   } else {
+      // The WD has been queued, wake up a parked thread (if any) to run it
+      thread_manager->wakeUpParked();
    }
 
 }
@@ -151,12 +159,15 @@ void Scheduler::_submit ( WD ** wds, size_t numElems )
    
    BaseThread *mythread = myThread;
    
-   // create a vector of threads for each wd
-   BaseThread ** threadList = NEW BaseThread*[numElems];
+   // create a vector of threads for each wd (on the stack for usual batch sizes)
+   BaseThread * localThreadList[NANOS_SUCC_RELEASE_BATCH];
+   BaseThread ** threadList = numElems <= NANOS_SUCC_RELEASE_BATCH ? localThreadList : NEW BaseThread*[numElems];
    for( size_t i = 0; i < numElems; ++i )
    {
       WD* wd = wds[i];
       wd->_mcontrol.preInit();
+      wd->submitted();
+      wd->setReady();
       
       // If the wd is tied to anyone
       BaseThread *wd_tiedto = wd->isTiedTo();
@@ -177,9 +188,10 @@ void Scheduler::_submit ( WD ** wds, size_t numElems )
    
    // Call the scheduling policy
    mythread->getTeam()->getSchedulePolicy().queue( threadList, wds, numElems );
+   sys.getThreadManager()->wakeUpParked( numElems );
    
    // Release
-   delete[] threadList;
+   if ( threadList != localThreadList ) delete[] threadList;
 }
 
 void Scheduler::updateCreateStats ( WD &wd )
@@ -191,7 +203,7 @@ void Scheduler::updateCreateStats ( WD &wd )
 
 void Scheduler::updateExitStats ( WD &wd )
 {
-   sys.throttleTaskOut();
+   sys.throttleTaskOut( wd );
    if ( wd.isConfigured() ) sys.getSchedulerStats()._totalTasks--;
 }
 
@@ -256,6 +268,11 @@ inline void Scheduler::idleLoop ()
 
    ThreadManager *const thread_manager = sys.getThreadManager();
 
+   // Adaptive idle: spin time is learnt from the length of previous idle phases
+   const bool adaptive = thread_manager->isAdaptive();
+   AdaptiveIdle adaptive_idle( thread_manager->getMaxSpinTime() );
+   double idle_start = adaptive ? OS::getMonotonicTime() : 0.0;
+
    WD *current = myThread->getCurrentWD();
    sys.getSchedulerStats()._idleThreads++;
    myThread->setIdle( true );
@@ -310,6 +327,8 @@ inline void Scheduler::idleLoop ()
          spins = init_spins;
          yields = init_yields;
 
+         if ( adaptive ) idle_start = OS::getMonotonicTime();
+
       }//thread going to sleep, thread waiking up
 
       if ( !thread->isRunning() && !thread->hasNextWD() ) {
@@ -327,7 +346,7 @@ inline void Scheduler::idleLoop ()
 
       if ( !next && thread->getTeam() != NULL ) {
          memoryFence();
-         if ( sys.getSchedulerStats()._readyTasks > 0 ) {
+         if ( sys.getSchedulerStats()._readyTasks.approximate() > 0 ) {
             NANOS_INSTRUMENT ( total_scheds++; )
             NANOS_INSTRUMENT ( unsigned long long begin_sched = (unsigned long long) ( OS::getMonotonicTime() * 1.0e9  ); )
             
@@ -374,6 +393,8 @@ inline void Scheduler::idleLoop ()
          thread->setIdle( false );
          sys.getSchedulerStats()._idleThreads--;
 
+         if ( adaptive ) adaptive_idle.record( OS::getMonotonicTime() - idle_start );
+
          behaviour::switchWD(thread, current, next);
 
          thread = getMyThreadSafe();
@@ -398,6 +419,8 @@ inline void Scheduler::idleLoop ()
          num_steals = 0;
          // Also reset the number of empty calls
          num_empty_calls = 0;
+
+         if ( adaptive ) idle_start = OS::getMonotonicTime();
          continue;
       }
       
@@ -412,12 +435,14 @@ inline void Scheduler::idleLoop ()
       if ( spins == 0 ) {
          NANOS_INSTRUMENT ( total_spins += init_spins; )
 
-         // Perform yield and/or block
-         thread_manager->idle( yields
+         // Perform yield and/or block, unless the adaptive policy expects work soon
+         if ( !adaptive || !adaptive_idle.keepSpinning( OS::getMonotonicTime() - idle_start ) ) {
+            thread_manager->idle( yields
 #ifdef NANOS_INSTRUMENTATION_ENABLED
-               , total_yields, total_blocks, time_yields, time_blocks
+                  , total_yields, total_blocks, time_yields, time_blocks
 #endif
-               );
+                  );
+         }
 
          spins = init_spins;
       }
@@ -465,7 +490,7 @@ void Scheduler::waitOnCondition (GenericSyncCond *condition)
                //! Second calling scheduler policy at block
                if ( !next ) {
                   memoryFence();
-                  if ( sys.getSchedulerStats()._readyTasks > 0 ) {
+                  if ( sys.getSchedulerStats()._readyTasks.approximate() > 0 ) {
                      if ( sys.getSchedulerConf().getSchedulerEnabled() )
                         next = thread->getTeam()->getSchedulePolicy().atBlock( thread, current );
             if ( next != NULL ) {
@@ -598,8 +623,7 @@ struct AsyncWorkerBehaviour
          // Since this is the async behavior, set schedule to false:
          // do not prefetch at this point, as the thread will be always prefetching
          if ( Scheduler::inlineWorkAsync ( next, /* schedule */ false ) ) {
-            next->~WorkDescriptor();
-            delete[] ( char * ) next;
+            WorkDescriptor::freeChunk( next );
          }
       }
    }
@@ -959,8 +983,7 @@ void Scheduler::switchTo ( WD *to )
 
    } else {
       if (inlineWork(to, /*schedule*/ true)) {
-         to->~WorkDescriptor();
-         delete[] (char *)to;
+         WorkDescriptor::freeChunk( to );
       }
    }
 }
@@ -996,8 +1019,7 @@ void Scheduler::exitHelper (WD *oldWD, WD *newWD, void *arg)
 {
     myThread->exitHelperDependent(oldWD, newWD, arg);
     myThread->setCurrentWD( *newWD );
-    oldWD->~WorkDescriptor();
-    delete[] (char *)oldWD;
+    WorkDescriptor::freeChunk( oldWD );
 }
 
 struct ExitBehaviour
@@ -1014,8 +1036,7 @@ struct ExitBehaviour
       }
       else {
         if ( Scheduler::inlineWork ( next /*jb merge */, /*schedule*/ true ) ) {
-          next->~WorkDescriptor();
-          delete[] (char *)next;
+          WorkDescriptor::freeChunk( next );
         }
       }
    }
@@ -1080,6 +1101,6 @@ void Scheduler::exit ( void )
    fatal("A thread should never return from Scheduler::exit");
 }
 
-int SchedulerStats::getCreatedTasks() { return _createdTasks.value(); }
-int SchedulerStats::getReadyTasks() { return _readyTasks.value(); }
-int SchedulerStats::getTotalTasks() { return _totalTasks.value(); }
+int SchedulerStats::getCreatedTasks() { return _createdTasks.approximate(); }
+int SchedulerStats::getReadyTasks() { return _readyTasks.approximate(); }
+int SchedulerStats::getTotalTasks() { return _totalTasks.approximate(); }
@@ -25,6 +25,7 @@
 #include <algorithm>
 
 #include "atomic.hpp"
+#include "shardedcounter.hpp"
 #include "synchronizedcondition_fwd.hpp"
 
 #include "schedule_decl.hpp"
@@ -33,6 +34,7 @@
 
 #include "functors.hpp"
 #include "basethread.hpp"
+#include "taskgraph_decl.hpp"
 
 namespace nanos {
 
@@ -79,6 +81,11 @@ inline bool SchedulerConf::getHoldTasksEnabled ( void ) const
    return _holdTasks;
 }
 
+inline size_t SchedulerConf::getPrefetchData ( void ) const
+{
+   return _prefetchData;
+}
+
 inline const std::string & SchedulePolicy::getName () const
 {
    return _name;
@@ -175,6 +182,7 @@ inline bool SchedulePolicy::testDequeue()
 inline void SchedulePolicySuccessorFunctor::operator() ( DependableObject *predecessor, DependableObject *successor )
 {
    _obj.successorFound( predecessor, successor );
+   if ( _graph != NULL ) _graph->captureEdge( *predecessor, *successor );
 }
 
 } // namespace nanos
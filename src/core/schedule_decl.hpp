@@ -30,9 +30,12 @@
 
 #include "workdescriptor_decl.hpp"
 #include "atomic_decl.hpp"
+#include "shardedcounter_decl.hpp"
 #include "functors_decl.hpp"
 #include "basethread_decl.hpp"
 
+//! Maximum number of ready WDs handed to the scheduler at once on successor release
+#define NANOS_SUCC_RELEASE_BATCH 64
 
 namespace nanos {
 
@@ -99,13 +102,14 @@ namespace nanos {
          bool                          _schedulerEnabled;  //!< Scheduler is enabled
          int                           _numStealAfterSpins;//!< Steal every so spins
          bool                          _holdTasks;         //!< Submit tasks when a taskwait is reached
+         size_t                        _prefetchData;      //!< Bytes of copies to prefetch for a thread's next WD (0 = disabled)
       private: /* PRIVATE METHODS */
         //! \brief SchedulerConf default constructor (private)
         SchedulerConf() : _numSpins(1), _numChecks(1), _schedulerEnabled(true),
-        _numStealAfterSpins(1), _holdTasks(false) {}
+        _numStealAfterSpins(1), _holdTasks(false), _prefetchData(0) {}
         //! \brief SchedulerConf copy constructor (private)
         SchedulerConf ( SchedulerConf &sc ) : _numSpins(), _numChecks(),
-        _schedulerEnabled(), _holdTasks()
+        _schedulerEnabled(), _holdTasks(), _prefetchData()
         {
            fatal("SchedulerConf: Illegal use of class");
         }
@@ -128,6 +132,8 @@ namespace nanos {
          bool getSchedulerEnabled () const;
          //! \brief Returns if holding tasks is enabled
          bool getHoldTasksEnabled () const;
+         //! \brief Returns the number of bytes to prefetch for a thread's next WD
+         size_t getPrefetchData () const;
 
          //! \brief Configure scheduler runtime options
          void config ( Config &cfg );
@@ -137,8 +143,11 @@ namespace nanos {
    {
          friend class WDDeque;
          friend class WDLFQueue;
+         friend class WDWorkStealingDeque;
          friend class WDPriorityQueue<WD::PriorityType>;
          friend class WDPriorityQueue<double>;
+         friend class WDHeapPriorityQueue<WD::PriorityType>;
+         friend class WDHeapPriorityQueue<double>;
          friend class Scheduler;
          friend class System;
 
@@ -148,10 +157,10 @@ namespace nanos {
          friend class SlicerRepeatN;
          friend class SlicerCompoundWD;
       private:
-         Atomic<int>          _createdTasks;
-         Atomic<int>          _readyTasks;
-         Atomic<int>          _idleThreads;
-         Atomic<int>          _totalTasks;
+         ShardedCounter       _createdTasks;
+         ShardedCounter       _readyTasks;
+         ShardedCounter       _idleThreads;
+         ShardedCounter       _totalTasks;
       private:
          /*! \brief SchedulerStats copy constructor (private)
           */
@@ -169,17 +178,7 @@ namespace nanos {
 
          int getCreatedTasks();
          int getReadyTasks();
-#ifdef HAVE_NEW_GCC_ATOMIC_OPS
-         int * getReadyTasksAddr( void ) { return &_readyTasks.override(); }
-#else
-         volatile int * getReadyTasksAddr( void ) { return &_readyTasks.override(); }
-#endif
          int getTotalTasks();
-#ifdef HAVE_NEW_GCC_ATOMIC_OPS
-         int * getTotalTasksAddr( void ) { return &_totalTasks.override(); }
-#else
-         volatile int * getTotalTasksAddr( void ) { return &_totalTasks.override(); }
-#endif
    };
 
    class ScheduleTeamData {
@@ -377,8 +376,9 @@ namespace nanos {
    struct SchedulePolicySuccessorFunctor
    {
       SchedulePolicy& _obj;
+      TaskGraph      *_graph;   //!< Graph recording the edges (NULL if not capturing)
 
-      SchedulePolicySuccessorFunctor( SchedulePolicy& obj ) : _obj( obj ) {}
+      SchedulePolicySuccessorFunctor( SchedulePolicy& obj, TaskGraph *graph = NULL ) : _obj( obj ), _graph( graph ) {}
 
       void operator() ( DependableObject *predecessor, DependableObject *successor );
    };
@@ -0,0 +1,187 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+
+#ifndef _NANOS_SUCCESSOR_LIST
+#define _NANOS_SUCCESSOR_LIST
+
+#include "successorlist_decl.hpp"
+#include "new_decl.hpp"
+
+namespace nanos {
+
+inline SuccessorList::SuccessorList ( const SuccessorList &list )
+   : _first( NULL ), _last( NULL ), _used( 0 ), _size( 0 )
+{
+   for ( iterator it = list.begin(); it != list.end(); it++ ) append( *it );
+}
+
+inline const SuccessorList & SuccessorList::operator= ( const SuccessorList &list )
+{
+   if ( this == &list ) return *this;
+
+   clear();
+   for ( iterator it = list.begin(); it != list.end(); it++ ) append( *it );
+   return *this;
+}
+
+inline SuccessorList::~SuccessorList ( )
+{
+   clear();
+}
+
+inline SuccessorList::value_type * SuccessorList::slot ( unsigned int pos, Chunk *chunk ) const
+{
+   if ( pos < NANOS_SUCC_INLINE ) return const_cast<value_type *>( &_inline[pos] );
+   return &chunk->_elems[( pos - NANOS_SUCC_INLINE ) % NANOS_SUCC_CHUNK];
+}
+
+inline SuccessorList::Chunk * SuccessorList::chunkOf ( unsigned int pos ) const
+{
+   if ( pos < NANOS_SUCC_INLINE ) return NULL;
+
+   Chunk *chunk = _first;
+   for ( unsigned int i = ( pos - NANOS_SUCC_INLINE ) / NANOS_SUCC_CHUNK; i > 0 && chunk != NULL; i-- ) {
+      chunk = chunk->_next;
+   }
+   return chunk;
+}
+
+inline void SuccessorList::append ( value_type succ )
+{
+   if ( _used < NANOS_SUCC_INLINE ) {
+      _inline[_used] = succ;
+   } else {
+      unsigned int idx = ( _used - NANOS_SUCC_INLINE ) % NANOS_SUCC_CHUNK;
+      if ( idx == 0 ) {
+         Chunk *chunk = NEW Chunk;
+         chunk->_next = NULL;
+         if ( _last == NULL ) _first = chunk;
+         else _last->_next = chunk;
+         _last = chunk;
+      }
+      _last->_elems[idx] = succ;
+   }
+   _used++;
+   _size++;
+}
+
+inline SuccessorList::iterator SuccessorList::begin ( ) const
+{
+   iterator it( this, 0, NULL );
+   it.skipHoles();
+   return it;
+}
+
+inline SuccessorList::iterator SuccessorList::end ( ) const
+{
+   return iterator( this, _used, NULL );
+}
+
+inline bool SuccessorList::insert ( value_type succ )
+{
+   // Look for the same edge among the latest entries of the last chunk (or the inline ones)
+   unsigned int lower = _used > NANOS_SUCC_DUP_WINDOW ? _used - NANOS_SUCC_DUP_WINDOW : 0;
+   if ( _used > NANOS_SUCC_INLINE ) {
+      unsigned int chunkStart = _used - 1 - ( _used - 1 - NANOS_SUCC_INLINE ) % NANOS_SUCC_CHUNK;
+      if ( lower < chunkStart ) lower = chunkStart;
+   }
+   for ( unsigned int pos = _used; pos > lower; pos-- ) {
+      if ( *slot( pos - 1, _last ) == succ ) return false;
+   }
+
+   append( succ );
+   return true;
+}
+
+inline SuccessorList::iterator SuccessorList::find ( value_type succ ) const
+{
+   iterator it = begin();
+   while ( it != end() && *it != succ ) it++;
+   return it;
+}
+
+inline void SuccessorList::erase ( iterator it )
+{
+   *it = NULL;
+   _size--;
+}
+
+inline size_t SuccessorList::erase ( value_type succ )
+{
+   size_t erased = 0;
+   for ( iterator it = begin(); it != end(); it++ ) {
+      if ( *it == succ ) {
+         erase( it );
+         erased++;
+      }
+   }
+   return erased;
+}
+
+inline void SuccessorList::clear ( )
+{
+   while ( _first != NULL ) {
+      Chunk *chunk = _first;
+      _first = chunk->_next;
+      delete chunk;
+   }
+   _last = NULL;
+   _used = 0;
+   _size = 0;
+}
+
+inline SuccessorList::iterator::iterator ( const SuccessorList *list, unsigned int pos, Chunk *chunk )
+   : _list( list ), _pos( pos ), _chunk( chunk ) {}
+
+inline void SuccessorList::iterator::step ( )
+{
+   _pos++;
+   if ( _pos >= NANOS_SUCC_INLINE && ( _pos - NANOS_SUCC_INLINE ) % NANOS_SUCC_CHUNK == 0 ) {
+      // Crossing a chunk boundary, the next chunk may not exist yet: it will be looked up on demand
+      _chunk = ( _pos == NANOS_SUCC_INLINE || _chunk == NULL ) ? NULL : _chunk->_next;
+   }
+}
+
+inline void SuccessorList::iterator::skipHoles ( )
+{
+   while ( _pos < _list->_used && **this == NULL ) step();
+}
+
+inline SuccessorList::value_type & SuccessorList::iterator::operator* ( ) const
+{
+   if ( _chunk == NULL ) _chunk = _list->chunkOf( _pos );
+   return *_list->slot( _pos, _chunk );
+}
+
+inline SuccessorList::iterator & SuccessorList::iterator::operator++ ( )
+{
+   step();
+   skipHoles();
+   return *this;
+}
+
+inline SuccessorList::iterator SuccessorList::iterator::operator++ ( int )
+{
+   iterator it( *this );
+   ++( *this );
+   return it;
+}
+
+} // namespace nanos
+
+#endif
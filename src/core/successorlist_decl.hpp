@@ -0,0 +1,147 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+
+#ifndef _NANOS_SUCCESSOR_LIST_DECL
+#define _NANOS_SUCCESSOR_LIST_DECL
+#include <stddef.h>
+
+#include "dependableobject_fwd.hpp"
+
+//! Number of successors stored inside the list object itself
+#define NANOS_SUCC_INLINE        4
+//! Number of successors stored by each overflow chunk
+#define NANOS_SUCC_CHUNK        31
+//! Number of most recent entries checked when looking for a duplicated edge
+#define NANOS_SUCC_DUP_WINDOW    8
+
+namespace nanos {
+
+   /*! \class SuccessorList
+    *  \brief Append-only list of the successors of a DependableObject
+    *
+    *  The first NANOS_SUCC_INLINE successors live inside the list object, the rest
+    *  are appended to a chain of fixed size chunks, so most edges of a task graph
+    *  do not allocate memory at all. Erasing a successor leaves a hole that the
+    *  iterators skip; entries are never moved, so iterators remain valid across
+    *  insert() and erase().
+    *
+    *  All edges towards a successor are created while that successor is being
+    *  submitted, so a duplicated edge is always one of the latest insertions and
+    *  insert() only looks for it among the last NANOS_SUCC_DUP_WINDOW entries. An
+    *  edge that is repeated beyond that window is simply stored twice, which is
+    *  harmless because the successor also counts that edge twice in its number
+    *  of predecessors.
+    *
+    *  The list is not thread safe, callers must hold the lock of the owner object.
+    */
+   class SuccessorList
+   {
+      public:
+         typedef DependableObject * value_type;
+
+      private:
+         struct Chunk {
+            value_type     _elems[NANOS_SUCC_CHUNK];
+            Chunk         *_next;
+         };
+
+         value_type        _inline[NANOS_SUCC_INLINE]; /**< First successors */
+         Chunk            *_first;                     /**< First overflow chunk */
+         Chunk            *_last;                      /**< Last overflow chunk */
+         unsigned int      _used;                      /**< Used slots, including holes */
+         unsigned int      _size;                      /**< Number of successors */
+
+         value_type * slot ( unsigned int pos, Chunk *chunk ) const;
+         Chunk * chunkOf ( unsigned int pos ) const;
+         void append ( value_type succ );
+
+      public:
+         /*! \class SuccessorList::iterator
+          *  \brief Forward iterator over the successors, skipping erased entries
+          */
+         class iterator
+         {
+            private:
+               friend class SuccessorList;
+
+               const SuccessorList *_list;
+               unsigned int         _pos;
+               mutable Chunk       *_chunk;  /**< Chunk holding _pos (NULL if unknown or inline) */
+
+               iterator ( const SuccessorList *list, unsigned int pos, Chunk *chunk );
+               void step ( );
+               void skipHoles ( );
+            public:
+               iterator ( ) : _list( NULL ), _pos( 0 ), _chunk( NULL ) {}
+
+               value_type & operator* ( ) const;
+               iterator & operator++ ( );
+               iterator operator++ ( int );
+               bool operator== ( const iterator &other ) const { return _pos == other._pos; }
+               bool operator!= ( const iterator &other ) const { return _pos != other._pos; }
+         };
+         typedef iterator const_iterator;
+
+         /*! \brief SuccessorList default constructor
+          */
+         SuccessorList ( ) : _first( NULL ), _last( NULL ), _used( 0 ), _size( 0 ) {}
+
+         /*! \brief SuccessorList copy constructor
+          */
+         SuccessorList ( const SuccessorList &list );
+
+         /*! \brief SuccessorList copy assignment operator, can be self-assigned.
+          */
+         const SuccessorList & operator= ( const SuccessorList &list );
+
+         /*! \brief SuccessorList destructor
+          */
+         ~SuccessorList ( );
+
+         iterator begin ( ) const;
+         iterator end ( ) const;
+
+         size_t size ( ) const { return _size; }
+         bool empty ( ) const { return _size == 0; }
+
+         /*! \brief Appends a successor
+          *  \return false if succ was already one of the most recent entries
+          */
+         bool insert ( value_type succ );
+
+         /*! \brief Returns an iterator to succ or end() if it is not in the list
+          */
+         iterator find ( value_type succ ) const;
+
+         /*! \brief Erases the successor pointed by it, other iterators are not invalidated
+          */
+         void erase ( iterator it );
+
+         /*! \brief Erases every occurrence of succ
+          *  \return number of erased entries
+          */
+         size_t erase ( value_type succ );
+
+         /*! \brief Erases all the successors and frees the overflow chunks
+          */
+         void clear ( );
+   };
+
+} // namespace nanos
+
+#endif
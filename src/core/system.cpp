@@ -45,6 +45,7 @@
 #include "router.hpp"
 #include "addressspace.hpp"
 #include "globalregt.hpp"
+#include "taskgraph.hpp"
 
 #ifdef SPU_DEV
 #include "spuprocessor.hpp"
@@ -86,7 +87,7 @@ System::System () :
       _instrument( false ), _verboseMode( false ), _summary( false ), _executionMode( DEDICATED ), _initialMode( POOL ),
       _untieMaster( true ), _delayedStart( false ), _synchronizedStart( true ), _alreadyFinished( false ),
       _predecessorLists( false ), _throttlePolicy ( NULL ),
-      _schedStats(), _schedConf(), _defSchedule( "bf" ), _defThrottlePolicy( "hysteresis" ), 
+      _schedStats(), _wdAllocator(), _schedConf(), _defSchedule( "bf" ), _defThrottlePolicy( "hysteresis" ), 
       _defBarr( "centralized" ), _defInstr ( "empty_trace" ), _defDepsManager( "plain" ), _defArch( "smp" ),
       _initializedThreads ( 0 ), /*_targetThreads ( 0 ),*/ _pausedThreads( 0 ),
       _pausedThreadsCond(), _unpausedThreadsCond(),
@@ -423,6 +424,7 @@ void System::config ()
    // Other configure options 
    _schedConf.config( cfg );
    _hwloc.config( cfg );
+   _wdAllocator.config( cfg );
    _threadManagerConf.config( cfg );
 
    verbose0 ( "Reading Configuration" );
@@ -682,7 +684,7 @@ void System::finish ()
    verbose ( "...thread has been joined" );
 
 
-   ensure( _schedStats._readyTasks == 0, "Ready task counter has an invalid value!");
+   ensure( _schedStats._readyTasks.value() == 0, "Ready task counter has an invalid value!");
 
    verbose ( "NANOS++ statistics");
    verbose ( std::dec << (unsigned int) getCreatedTasks() << " tasks has been executed" );
@@ -765,6 +767,12 @@ void System::finish ()
    verbose0 ( "NANOS++ shutting down.... end" );
    //! \note printing execution summary
    if ( _summary ) executionSummary();
+   //! \note printing WD slab allocator statistics
+   if ( _wdAllocator.isPrintStatsEnabled() ) {
+      std::ostringstream output;
+      _wdAllocator.printStats( output );
+      message0( output.str() );
+   }
 
    _net.finalize(); //this can call exit (because of GASNet)
 }
@@ -888,7 +896,10 @@ void System::createWD ( WD **uwd, size_t num_devices, nanos_device_t *devices, s
       total_size = NANOS_ALIGNED_MEMORY_OFFSET(offset_PMD,size_PMD,1);
    }
 
-   chunk = NEW char[total_size];
+   // WD chunks come from the calling thread slab cache, but user supplied WDs keep the old path
+   bool slab_chunk = ( *uwd == NULL );
+   if ( slab_chunk ) chunk = (char *) _wdAllocator.allocate( total_size );
+   else chunk = NEW char[total_size];
    if ( props != NULL ) {
       if (props->clear_chunk)
           memset(chunk, 0, sizeof(char) * total_size);
@@ -923,6 +934,7 @@ void System::createWD ( WD **uwd, size_t num_devices, nanos_device_t *devices, s
    
    // Set total size
    wd->setTotalSize(total_size );
+   wd->setSlabChunk( slab_chunk );
    
    if ( wd->getNUMANode() >= (int)sys.getNumNumaNodes() )
       throw NANOS_INVALID_PARAM;
@@ -975,6 +987,21 @@ void System::createWD ( WD **uwd, size_t num_devices, nanos_device_t *devices, s
    if (uwg) wd->copyReductions((WorkDescriptor *)uwg);
 }
 
+void System::createWDs ( size_t numWDs, WD **uwds, size_t num_devices, nanos_device_t *devices, size_t data_size,
+                         size_t data_align, void **data, WD *uwg, nanos_wd_props_t *props, nanos_wd_dyn_props_t *dyn_props,
+                         size_t num_copies, nanos_copy_data_t **copies, size_t num_dimensions,
+                         nanos_region_dimension_internal_t **dimensions, const char *description )
+{
+   for ( size_t i = 0; i < numWDs; i++ ) {
+      uwds[i] = NULL;
+      data[i] = NULL;
+      if ( copies != NULL ) copies[i] = NULL;
+      createWD( &uwds[i], num_devices, devices, data_size, data_align, &data[i], uwg, props, dyn_props,
+                num_copies, copies != NULL ? &copies[i] : NULL, num_dimensions, dimensions != NULL ? &dimensions[i] : NULL,
+                NULL, description, NULL );
+   }
+}
+
 /*! \brief Duplicates the whole structure for a given WD
  *
  *  \param [out] uwd is the target addr for the new WD
@@ -1061,7 +1088,9 @@ void System::duplicateWD ( WD **uwd, WD *wd)
       total_size = NANOS_ALIGNED_MEMORY_OFFSET(offset_PMD,size_PMD,1);
    }
 
-   chunk = NEW char[total_size];
+   bool slab_chunk = ( *uwd == NULL );
+   if ( slab_chunk ) chunk = (char *) _wdAllocator.allocate( total_size );
+   else chunk = NEW char[total_size];
 
    // allocating WD and DATA; if size_Data == 0 data keep the NULL value
    if ( *uwd == NULL ) *uwd = (WD *) chunk;
@@ -1095,12 +1124,14 @@ void System::duplicateWD ( WD **uwd, WD *wd)
 
    // Set total size
    (*uwd)->setTotalSize(total_size );
+   (*uwd)->setSlabChunk( slab_chunk );
    
    // initializing internal data
    if ( size_PMD != 0) {
       _pmInterface->initInternalData( chunk + offset_PMD );
       (*uwd)->setInternalData( chunk + offset_PMD );
-      memcpy ( chunk + offset_PMD, wd->getInternalData(), size_PMD );
+      // WDs built outside System::createWD may have no internal data to copy
+      if ( wd->getInternalData() != NULL ) memcpy ( chunk + offset_PMD, wd->getInternalData(), size_PMD );
    }
    
    // Create Scheduling data
@@ -1136,14 +1167,51 @@ void System::submit ( WD &work )
    SchedulePolicy* policy = getDefaultSchedulePolicy();
    policy->onSystemSubmit( work, SchedulePolicy::SYS_SUBMIT );
 
+   // Tasks without dependences are captured too, although they are not held
+   WD *current = myThread->getCurrentWD();
+   if ( current != NULL && current->getCapturedGraph() != NULL && work.getParent() == current ) {
+      current->getCapturedGraph()->captureNode( work, 0, NULL );
+   }
+
    work.submit();
 }
 
+//! \brief Submit a batch of WorkDescriptors with no dependencies
+void System::submit ( WD **works, size_t numWorks )
+{
+   SchedulePolicy* policy = getDefaultSchedulePolicy();
+   BaseThread *mythread = myThread;
+   WD *current = mythread->getCurrentWD();
+   TaskGraph *graph = current != NULL ? current->getCapturedGraph() : NULL;
+
+   std::vector<WD *> batch;
+   batch.reserve( numWorks );
+
+   for ( size_t i = 0; i < numWorks; i++ ) {
+      WD &work = *works[i];
+      policy->onSystemSubmit( work, SchedulePolicy::SYS_SUBMIT );
+
+      if ( graph != NULL && work.getParent() == current ) {
+         graph->captureNode( work, 0, NULL );
+      }
+
+      // The batch path of the scheduler neither slices nor hands WDs to other threads
+      if ( work.getSlicer() != NULL || ( work.isTied() && work.isTiedTo() != mythread ) ) {
+         work.submit();
+      } else {
+         batch.push_back( &work );
+      }
+   }
+
+   if ( !batch.empty() ) Scheduler::submit( &batch[0], batch.size() );
+}
+
 //! \brief Submit WorkDescriptor to its parent's  dependencies domain
 void System::submitWithDependencies (WD& work, size_t numDataAccesses, DataAccess* dataAccesses)
 {
    SchedulePolicy* policy = getDefaultSchedulePolicy();
    policy->onSystemSubmit( work, SchedulePolicy::SYS_SUBMIT_WITH_DEPENDENCIES );
+   throttleTaskSubmit( work, numDataAccesses, dataAccesses );
 
    WD *current = myThread->getCurrentWD(); 
    current->submitWithDependencies( work, numDataAccesses , dataAccesses);
@@ -25,6 +25,7 @@
 #include <vector>
 #include <string>
 #include "schedule_decl.hpp"
+#include "shardedcounter.hpp"
 #include "threadteam.hpp"
 #include "slicer.hpp"
 #include "nanos-int.h"
@@ -32,6 +33,7 @@
 #include "instrumentation_decl.hpp"
 #include "synchronizedcondition.hpp"
 #include "regioncache.hpp"
+#include "slaballocator.hpp"
 #include <cmath>
 #include <climits>
 
@@ -69,15 +71,15 @@ inline void System::setDelayedStart ( bool set) { _delayedStart = set; }
 
 inline bool System::getDelayedStart () const { return _delayedStart; }
 
-inline int System::getCreatedTasks() const { return _schedStats._createdTasks.value(); }
+inline int System::getCreatedTasks() const { return _schedStats._createdTasks.approximate(); }
 
-inline int System::getTaskNum() const { return _schedStats._totalTasks.value(); }
+inline int System::getTaskNum() const { return _schedStats._totalTasks.approximate(); }
 
-inline int System::getReadyNum() const { return _schedStats._readyTasks.value(); }
+inline int System::getReadyNum() const { return _schedStats._readyTasks.approximate(); }
 
-inline int System::getIdleNum() const { return _schedStats._idleThreads.value(); }
+inline int System::getIdleNum() const { return _schedStats._idleThreads.approximate(); }
 
-inline int System::getRunningTasks() const { return _workers.size() - _schedStats._idleThreads.value(); }
+inline int System::getRunningTasks() const { return _workers.size() - _schedStats._idleThreads.approximate(); }
 
 inline void System::setUntieMaster ( bool value ) { _untieMaster = value; }
 inline bool System::getUntieMaster () const { return _untieMaster; }
@@ -417,7 +419,15 @@ inline PinnedAllocator& System::getPinnedAllocatorCUDA() { return _pinnedMemoryC
 
 
 inline bool System::throttleTaskIn ( void ) const { return _throttlePolicy->throttleIn(); }
-inline void System::throttleTaskOut ( void ) const { _throttlePolicy->throttleOut(); }
+inline void System::throttleTaskSubmit ( WD &work, size_t numDataAccesses, DataAccess* dataAccesses ) const
+{
+   _throttlePolicy->throttleSubmit( work, numDataAccesses, dataAccesses );
+}
+inline void System::throttleTaskOut ( WD &work ) const
+{
+   _throttlePolicy->throttleFinish( work );
+   _throttlePolicy->throttleOut();
+}
 
 inline void System::threadReady()
 {
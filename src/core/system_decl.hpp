@@ -41,6 +41,7 @@
 #include "addressspace_decl.hpp"
 #include "smpbaseplugin_decl.hpp"
 #include "hwloc_decl.hpp"
+#include "slaballocator_decl.hpp"
 #include "threadmanager_decl.hpp"
 #include "router_decl.hpp"
 
@@ -127,6 +128,7 @@ namespace nanos {
 
          ThrottlePolicy      *_throttlePolicy;
          SchedulerStats       _schedStats;
+         SlabAllocator        _wdAllocator;           //!< \brief Per thread slab caches used to allocate WD chunks
          SchedulerConf        _schedConf;
          std::string          _defSchedule;           //!< \brief Name of default scheduler
          std::string          _defThrottlePolicy;     //!< \brief Name of default throttole policy (cutoff)
@@ -303,6 +305,13 @@ namespace nanos {
 
 
          void submit ( WD &work );
+
+         /*! \brief Submits a batch of WDs without dependencies
+          *
+          *  WDs that can be queued directly are handed to the scheduler in a single
+          *  call, sliced WDs and WDs tied to other threads are submitted one by one.
+          */
+         void submit ( WD **works, size_t numWorks );
          void submitWithDependencies (WD& work, size_t numDataAccesses, DataAccess* dataAccesses);
          void waitOn ( size_t numDataAccesses, DataAccess* dataAccesses);
          void inlineWork ( WD &work );
@@ -313,6 +322,16 @@ namespace nanos {
                         size_t num_dimensions, nanos_region_dimension_internal_t **dimensions,
                         nanos_translate_args_t translate_args, const char *description, Slicer *slicer );
 
+         /*! \brief Creates numWDs WDs sharing the same definition
+          *
+          *  Equivalent to calling createWD for each WD with a NULL *uwd. copies and
+          *  dimensions, when not NULL, hold one entry per WD.
+          */
+         void createWDs ( size_t numWDs, WD **uwds, size_t num_devices, nanos_device_t *devices,
+                          size_t data_size, size_t data_align, void ** data, WD *uwg,
+                          nanos_wd_props_t *props, nanos_wd_dyn_props_t *dyn_props, size_t num_copies, nanos_copy_data_t **copies,
+                          size_t num_dimensions, nanos_region_dimension_internal_t **dimensions, const char *description );
+
          void duplicateWD ( WD **uwd, WD *wd );
 
         /* \brief prepares a WD to be scheduled/executed.
@@ -466,7 +485,8 @@ namespace nanos {
          void setThrottlePolicy( ThrottlePolicy * policy );
 
          bool throttleTaskIn( void ) const;
-         void throttleTaskOut( void ) const;
+         void throttleTaskSubmit( WD &work, size_t numDataAccesses, DataAccess* dataAccesses ) const;
+         void throttleTaskOut( WD &work ) const;
 
          const std::string & getDefaultSchedule() const;
 
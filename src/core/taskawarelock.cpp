@@ -0,0 +1,61 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "taskawarelock.hpp"
+
+using namespace nanos;
+
+void TaskAwareLock::block ()
+{
+   Waiter me;
+
+   _stateLock.acquire();
+   if ( !_held ) {
+      // Released while we were spinning
+      _held = true;
+      _stateLock.release();
+      return;
+   }
+   _waiters.push_back( &me );
+   _stateLock.release();
+
+   // The releaser may still be signaling when the condition holds, wait for it as 'me' is
+   // going out of scope
+   me.condition.waitConditionAndSignalers();
+}
+
+void TaskAwareLock::release ()
+{
+   _stateLock.acquire();
+   if ( _waiters.empty() ) {
+      _held = false;
+      _stateLock.release();
+      return;
+   }
+
+   // Hand off: the lock stays held and the first waiter becomes its owner
+   Waiter *next = _waiters.front();
+   _waiters.pop_front();
+   _stateLock.release();
+
+   next->condition.reference();
+   next->granted = true;
+   next->condition.signal();
+   next->condition.unreference();
+}
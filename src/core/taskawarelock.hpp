@@ -0,0 +1,67 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_TASK_AWARE_LOCK
+#define _NANOS_TASK_AWARE_LOCK
+
+#include "taskawarelock_decl.hpp"
+#include "lock.hpp"
+#include "synchronizedcondition.hpp"
+
+namespace nanos {
+
+inline TaskAwareLock::TaskAwareLock ( unsigned int spins ) : _stateLock(), _held( false ), _waiters(), _spins( spins ) {}
+
+inline TaskAwareLock::~TaskAwareLock ()
+{
+   ensure( _waiters.empty(), "Destroying a lock with blocked WDs" );
+}
+
+inline bool TaskAwareLock::tryAcquire ()
+{
+   // Skip the state lock when the lock is visibly taken
+   if ( _held ) return false;
+
+   bool acquired = false;
+   _stateLock.acquire();
+   if ( !_held ) {
+      _held = true;
+      acquired = true;
+   }
+   _stateLock.release();
+
+   return acquired;
+}
+
+inline void TaskAwareLock::acquire ()
+{
+   for ( unsigned int spin = 0; spin < _spins; spin++ ) {
+      if ( tryAcquire() ) return;
+   }
+   block();
+}
+
+inline bool TaskAwareLock::isHeld () const
+{
+   return _held;
+}
+
+} // namespace nanos
+
+#endif
@@ -0,0 +1,92 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_TASK_AWARE_LOCK_DECL
+#define _NANOS_TASK_AWARE_LOCK_DECL
+
+#include <deque>
+#include "taskawarelock_fwd.hpp"
+#include "lock_decl.hpp"
+#include "synchronizedcondition_decl.hpp"
+
+namespace nanos {
+
+   /*! \class TaskAwareLock
+    *  \brief Mutual exclusion lock that blocks the waiting WD instead of its thread
+    *
+    *  A WD that finds the lock taken spins for a while and then blocks on a condition of its own
+    *  through Scheduler::waitOnCondition, so the thread can run other ready tasks meanwhile.
+    *  Blocked WDs are queued in arrival order and the lock is handed off to the first one at
+    *  release: the lock is never seen free while there are waiters, so spinning WDs cannot
+    *  overtake the blocked ones.
+    */
+   class TaskAwareLock
+   {
+      private:
+         /*! \brief A WD blocked on the lock, lives in the stack of the WD */
+         struct Waiter {
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+            bool                                         granted;   /**< Set when the lock is handed off to this WD */
+#else
+            volatile bool                                granted;   /**< Set when the lock is handed off to this WD */
+#endif
+            SingleSyncCond<EqualConditionChecker<bool> > condition;
+
+            Waiter () : granted( false ), condition( EqualConditionChecker<bool>( &granted, true ) ) {}
+         };
+
+         typedef std::deque<Waiter *> WaiterList;
+
+         Lock              _stateLock;  /**< Protects _held and _waiters */
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+         bool              _held;
+#else
+         volatile bool     _held;
+#endif
+         WaiterList        _waiters;    /**< Blocked WDs, in arrival order */
+         unsigned int      _spins;      /**< Checks of the lock before blocking */
+
+      private:
+         /*! \brief TaskAwareLock copy constructor (disabled) */
+         TaskAwareLock ( const TaskAwareLock &lock );
+
+         /*! \brief TaskAwareLock copy assignment operator (disabled) */
+         const TaskAwareLock & operator= ( const TaskAwareLock &lock );
+
+         /*! \brief Queues the current WD and blocks it until the lock is handed off to it */
+         void block ();
+
+      public:
+         /*! \brief TaskAwareLock constructor
+          *  \param spins number of times the lock is checked before blocking the WD
+          */
+         TaskAwareLock ( unsigned int spins = 100 );
+
+         ~TaskAwareLock ();
+
+         void acquire ();
+         bool tryAcquire ();
+         void release ();
+
+         bool isHeld () const;
+   };
+
+} // namespace nanos
+
+#endif
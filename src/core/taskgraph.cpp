@@ -0,0 +1,145 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "taskgraph.hpp"
+#include "workdescriptor.hpp"
+#include "dependableobjectwd.hpp"
+#include "dependenciesdomain.hpp"
+#include "dataaccess.hpp"
+#include "schedule.hpp"
+#include "system.hpp"
+#include "debug.hpp"
+
+using namespace nanos;
+
+TaskGraph::TaskGraph () : _nodes(), _index(), _held(), _numEdges( 0 ), _replayable( true ) {}
+
+TaskGraph::~TaskGraph ()
+{
+   ensure( _held.empty(), "Destroying a task graph which is still being captured" );
+
+   for ( NodeList::iterator it = _nodes.begin(); it != _nodes.end(); it++ ) {
+      WorkDescriptor::freeChunk( it->_template );
+   }
+}
+
+void TaskGraph::captureNode ( WD &wd, size_t numDeps, DataAccess *deps )
+{
+   // The template is a detached copy: it is not a component of wd's parent
+   WD *tmpl = NULL;
+   sys.duplicateWD( &tmpl, &wd );
+   if ( tmpl->_parent != NULL ) {
+      tmpl->_parent->exitWork( *tmpl );
+      tmpl->_parent = NULL;
+   }
+
+   for ( size_t i = 0; i < numDeps; i++ ) {
+      if ( deps[i].isCommutative() || deps[i].isConcurrent() ) _replayable = false;
+   }
+
+   _index[wd.getId()] = _nodes.size();
+   _nodes.push_back( Node( tmpl ) );
+
+   DOSubmit *doSubmit = wd.getDOSubmit();
+   if ( doSubmit != NULL ) {
+      doSubmit->increasePredecessors();
+      _held.push_back( doSubmit );
+   }
+}
+
+void TaskGraph::captureEdge ( DependableObject &predecessor, DependableObject &successor )
+{
+   WD *predWD = predecessor.getWD();
+   WD *succWD = successor.getWD();
+   if ( predWD == NULL || succWD == NULL ) return;
+
+   NodeIndex::iterator pred = _index.find( predWD->getId() );
+   if ( pred == _index.end() ) return;
+   NodeIndex::iterator succ = _index.find( succWD->getId() );
+   if ( succ == _index.end() ) return;
+
+   _nodes[pred->second]._successors.push_back( succ->second );
+   _numEdges++;
+}
+
+void TaskGraph::endCapture ()
+{
+   _index.clear();
+
+   // A released task may finish and be deleted at any time, so the list is not touched afterwards
+   HeldList held;
+   held.swap( _held );
+   for ( HeldList::iterator it = held.begin(); it != held.end(); it++ ) {
+      (*it)->decreasePredecessors( NULL, NULL, false, false );
+   }
+}
+
+void TaskGraph::replay ( WD &parent, UpdateFunction update, void *arg )
+{
+   const unsigned int numNodes = _nodes.size();
+   if ( numNodes == 0 ) return;
+
+   ensure( _replayable, "Replaying a task graph with commutative or concurrent accesses" );
+
+   SchedulePolicy &policy = *sys.getDefaultSchedulePolicy();
+   SchedulePolicySuccessorFunctor cb( policy );
+   std::vector<DOSubmit *> dos( numNodes );
+
+   // Creating the tasks, each one with a fake predecessor as the dependences domain does
+   for ( unsigned int i = 0; i < numNodes; i++ ) {
+      WD *wd = NULL;
+      sys.duplicateWD( &wd, _nodes[i]._template );
+      parent.addWork( *wd );
+      wd->setDepth( parent.getDepth() + 1 );
+      sys.getPMInterface().setupWD( *wd );
+      Scheduler::updateCreateStats( *wd );
+
+      if ( update != NULL ) update( i, wd->getData(), arg );
+
+      DOSubmit *doSubmit = NEW DOSubmit();
+      doSubmit->setWD( wd );
+      doSubmit->increasePredecessors();
+      wd->_doSubmit = doSubmit;
+      dos[i] = doSubmit;
+   }
+
+   // Linking the recorded edges, no task can run yet
+   for ( unsigned int i = 0; i < numNodes; i++ ) {
+      EdgeList const &succ = _nodes[i]._successors;
+      for ( EdgeList::const_iterator it = succ.begin(); it != succ.end(); it++ ) {
+         if ( dos[i]->addSuccessor( *dos[*it] ) ) {
+            dos[*it]->increasePredecessors();
+            cb( dos[i], dos[*it] );
+         }
+      }
+   }
+
+   for ( unsigned int i = 0; i < numNodes; i++ ) {
+      policy.atCreate( *dos[i] );
+      dos[i]->submitted();
+   }
+
+   DependenciesDomain::increaseTasksInGraph( numNodes );
+
+   // Releasing the fake predecessors; a task may finish (and free its DOSubmit) as soon as it is released
+   for ( unsigned int i = 0; i < numNodes; i++ ) {
+      dos[i]->decreasePredecessors( NULL, NULL, false, false );
+   }
+}
+
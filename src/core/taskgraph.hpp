@@ -0,0 +1,45 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_TASK_GRAPH
+#define _NANOS_TASK_GRAPH
+
+#include "taskgraph_decl.hpp"
+
+namespace nanos {
+
+inline bool TaskGraph::isReplayable () const
+{
+   return _replayable;
+}
+
+inline size_t TaskGraph::getNumNodes () const
+{
+   return _nodes.size();
+}
+
+inline size_t TaskGraph::getNumEdges () const
+{
+   return _numEdges;
+}
+
+} // namespace nanos
+
+#endif
+
@@ -0,0 +1,127 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_TASK_GRAPH_DECL
+#define _NANOS_TASK_GRAPH_DECL
+
+#include <stddef.h>
+#include <vector>
+#include <map>
+#include "taskgraph_fwd.hpp"
+#include "workdescriptor_fwd.hpp"
+#include "dependableobject_fwd.hpp"
+#include "dependableobjectwd_fwd.hpp"
+#include "dataaccess_fwd.hpp"
+
+namespace nanos {
+
+   /*! \class TaskGraph
+    *  \brief Task graph recorded from the tasks submitted by a WD, which can be instantiated again
+    *  without going through the dependences domain.
+    *
+    *  While a WD is capturing, every task it submits is copied into a template node and every
+    *  edge the dependences domain finds between two captured tasks is recorded. Captured tasks
+    *  are held with an extra predecessor until the capture ends, so no edge is missed because its
+    *  predecessor had already finished. A replay duplicates the templates and links their DOSubmit
+    *  objects directly, so no address or region is looked up again.
+    *
+    *  Edges with tasks submitted outside the capture are not recorded: a replay has to be separated
+    *  from that work (and from other replays writing the same data) by a taskwait. The capturing WD
+    *  must not wait for its children before the capture ends. Graphs with commutative or concurrent
+    *  accesses are recorded but cannot be replayed, as their ordering is decided at run time.
+    */
+   class TaskGraph
+   {
+      public:
+         /*! \brief Function called for each instantiated node to update its arguments
+          *  \param node Index of the node, in submission order during the capture
+          *  \param data Arguments of the new WD (a copy of the captured ones)
+          *  \param arg User argument given to replay
+          */
+         typedef void (*UpdateFunction) ( unsigned int node, void *data, void *arg );
+      private:
+         typedef std::vector<unsigned int>      EdgeList;
+
+         struct Node {
+            WD          *_template;   /**< Copy of the captured WD, never executed */
+            EdgeList     _successors; /**< Indexes of the nodes depending on this one */
+
+            Node ( WD *tmpl ) : _template( tmpl ), _successors() {}
+         };
+
+         typedef std::vector<Node>              NodeList;
+         typedef std::map<int, unsigned int>    NodeIndex;   /**< Captured WD id to node index */
+         typedef std::vector<DOSubmit *>        HeldList;
+
+         NodeList          _nodes;      /**< Graph nodes, in submission order */
+         NodeIndex         _index;      /**< Node of each captured WD, only used while capturing */
+         HeldList          _held;       /**< Captured DOSubmits waiting for the end of the capture */
+         size_t            _numEdges;   /**< Number of recorded edges */
+         bool              _replayable; /**< False if some access cannot be replayed */
+
+      private:
+         /*! \brief TaskGraph copy constructor (disabled)
+          */
+         TaskGraph ( const TaskGraph &tg );
+         /*! \brief TaskGraph copy assignment operator (disabled)
+          */
+         const TaskGraph & operator= ( const TaskGraph &tg );
+      public:
+         /*! \brief TaskGraph default constructor
+          */
+         TaskGraph ();
+         /*! \brief TaskGraph destructor
+          */
+         ~TaskGraph ();
+
+         /*! \brief Records a task submitted by the capturing WD
+          *
+          *  When the task has a DOSubmit it is held until endCapture(), so it must be called
+          *  before the DOSubmit reaches the dependences domain.
+          */
+         void captureNode ( WD &wd, size_t numDeps, DataAccess *deps );
+
+         /*! \brief Records an edge found by the dependences domain
+          *
+          *  The edge is ignored unless both ends are captured tasks.
+          */
+         void captureEdge ( DependableObject &predecessor, DependableObject &successor );
+
+         /*! \brief Finishes the capture and releases the held tasks
+          */
+         void endCapture ();
+
+         /*! \brief Instantiates the graph as children of parent
+          *  \param parent WD the new tasks are added to (usually the current one)
+          *  \param update Function to update the arguments of each new task [Optional]
+          *  \param arg Argument passed to update
+          */
+         void replay ( WD &parent, UpdateFunction update, void *arg );
+
+         bool isReplayable () const;
+
+         size_t getNumNodes () const;
+
+         size_t getNumEdges () const;
+   };
+
+} // namespace nanos
+
+#endif
+
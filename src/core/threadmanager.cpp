@@ -30,8 +30,72 @@
 
 using namespace nanos;
 
+/**********************************/
+/********* Adaptive Idle **********/
+/**********************************/
+
+AdaptiveIdle::AdaptiveIdle( unsigned int max_spin_ns ) :
+   _samples( 0 ),
+   _maxSpinTime( max_spin_ns * 1.0e-9 ),
+   _spinTime( max_spin_ns * 1.0e-9 )
+{
+   for ( unsigned int i = 0; i < NUM_BUCKETS; i++ ) _histogram[i] = 0;
+}
+
+void AdaptiveIdle::record( double length )
+{
+   unsigned long long ns = (unsigned long long) ( length * 1.0e9 );
+   unsigned int bucket = 0;
+   while ( ( ns >>= 1 ) != 0 && bucket < NUM_BUCKETS - 1 ) bucket++;
+
+   _histogram[bucket]++;
+
+   if ( ++_samples == DECAY_PERIOD ) {
+      // Halve the history so the policy follows changes of application phase
+      _samples = 0;
+      for ( unsigned int i = 0; i < NUM_BUCKETS; i++ ) _histogram[i] >>= 1;
+   }
+
+   update();
+}
+
+void AdaptiveIdle::update()
+{
+   unsigned int total = 0, spinnable = 0, last = 0;
+   for ( unsigned int i = 0; i < NUM_BUCKETS; i++ ) {
+      total += _histogram[i];
+      // Upper bound of bucket i is 2^(i+1) ns
+      if ( ( (double) ( 1ULL << ( i + 1 ) ) ) * 1.0e-9 <= _maxSpinTime ) {
+         spinnable += _histogram[i];
+         last = i;
+      }
+   }
+
+   // Most of the waits are too long to be worth spinning: park as soon as possible
+   if ( total == 0 || spinnable * 2 < total ) {
+      _spinTime = 0.0;
+      return;
+   }
+
+   // Otherwise spin long enough to cover 90% of the short waits
+   unsigned int covered = 0;
+   for ( unsigned int i = 0; i <= last; i++ ) {
+      covered += _histogram[i];
+      if ( covered * 10 >= spinnable * 9 ) {
+         _spinTime = ( (double) ( 1ULL << ( i + 1 ) ) ) * 1.0e-9;
+         return;
+      }
+   }
+   _spinTime = _maxSpinTime;
+}
+
+/**********************************/
+/********* Thread Manager *********/
+/**********************************/
+
 ThreadManager::ThreadManager( bool warmup, bool tie_master, unsigned int num_yields,
-      unsigned int sleep_time, bool use_sleep, bool use_block, bool use_dlb ) :
+      unsigned int sleep_time, bool use_sleep, bool use_block, bool use_dlb,
+      bool use_adaptive, unsigned int max_spin_time ) :
    _lock(),
    _initialized( false ),
    _maxThreads(),
@@ -44,6 +108,9 @@ ThreadManager::ThreadManager( bool warmup, bool tie_master, unsigned int num_yie
    _useSleep( use_sleep ),
    _useBlock( use_block ),
    _useDLB( use_dlb ),
+   _useAdaptive( use_adaptive ),
+   _maxSpinTime( max_spin_time ),
+   _parkedThreads( 0 ), _parkSequence( 0 ),
    _self_managed_cpus()
 {
 }
@@ -76,7 +143,7 @@ void ThreadManager::init()
 #endif
 
    // Consider TM not initialized if there isn't any related flag
-   _initialized = _useSleep || _useBlock || _useDLB;
+   _initialized = _useSleep || _useBlock || _useDLB || _useAdaptive;
 }
 
 bool ThreadManager::isGreedy()
@@ -145,6 +212,16 @@ void ThreadManager::idle( int& yields
 #ifdef NANOS_INSTRUMENTATION_ENABLED
          double end_block = OS::getMonotonicTime();
          time_blocks += (unsigned long long) ( (end_block - begin_block) * 1e9 );
+#endif
+      } else if ( _useAdaptive ) {
+#ifdef NANOS_INSTRUMENTATION_ENABLED
+         total_blocks++;
+         double begin_block = OS::getMonotonicTime();
+#endif
+         parkThread( thread );
+#ifdef NANOS_INSTRUMENTATION_ENABLED
+         double end_block = OS::getMonotonicTime();
+         time_blocks += (unsigned long long) ( (end_block - begin_block) * 1e9 );
 #endif
       } else if ( _useSleep ) {
          OS::nanosleep( _sleepTime );
@@ -231,6 +308,39 @@ void ThreadManager::unblockThread( BaseThread* thread )
    sys.getSMPPlugin()->updateCpuStatus( cpuid );
 }
 
+void ThreadManager::parkThread( BaseThread *thread )
+{
+   // There is work that this thread could not get (e.g. tied to other thread,
+   // not runnable here), the futex would not sleep at all: just take a nap
+   if ( sys.getSchedulerStats().getReadyTasks() != 0 ) {
+      OS::nanosleep( _sleepTime );
+      return;
+   }
+
+   // The ready task counter is sharded and cannot be used as the futex word, so
+   // threads sleep on a sequence number that is bumped on each wake up. The
+   // thread announces itself before sampling the sequence and checking again for
+   // ready tasks, while a submitter queues its tasks before looking for parked
+   // threads: either we see the new tasks or the futex sees a new sequence.
+   // The timeout bounds the sleep in case the wake up comes from a path that
+   // does not notify (e.g. a task tied to this thread, a team change, shutdown)
+   _parkedThreads++;
+   memoryFence();
+   int sequence = _parkSequence.value();
+   if ( sys.getSchedulerStats().getReadyTasks() == 0 ) {
+      OS::futexWait( (int *) &_parkSequence.override(), sequence, ThreadManagerConf::DEFAULT_PARK_NS );
+   }
+   _parkedThreads--;
+}
+
+void ThreadManager::wakeUpParked( int num )
+{
+   if ( _parkedThreads.value() <= 0 ) return;
+
+   _parkSequence++;
+   OS::futexWake( (int *) &_parkSequence.override(), num );
+}
+
 void ThreadManager::lendCpu( BaseThread *thread )
 {
 #ifdef DLB
@@ -443,6 +553,8 @@ void ThreadManager::poll()
 
 const unsigned int ThreadManagerConf::DEFAULT_SLEEP_NS = 20000;
 const unsigned int ThreadManagerConf::DEFAULT_YIELDS = 10;
+const unsigned int ThreadManagerConf::DEFAULT_MAX_SPIN_NS = 100000;
+const unsigned int ThreadManagerConf::DEFAULT_PARK_NS = 1000000;
 
 ThreadManagerConf::ThreadManagerConf() :
    _numYields( DEFAULT_YIELDS ),
@@ -450,6 +562,8 @@ ThreadManagerConf::ThreadManagerConf() :
    _useSleep( false ),
    _useBlock( false ),
    _useDLB( false ),
+   _useAdaptive( false ),
+   _maxSpinTime( DEFAULT_MAX_SPIN_NS ),
    _forceTieMaster( false ),
    _warmupThreads( false )
 {
@@ -479,6 +593,16 @@ void ThreadManagerConf::config( Config &cfg )
    cfg.registerConfigOption ( "num-yields", NEW Config::UintVar( _numYields ), yield_sstream.str() );
    cfg.registerArgOption ( "num-yields", "yields" );
 
+   cfg.registerConfigOption( "enable-adaptive-idle", NEW Config::FlagOption( _useAdaptive, true ),
+         "Thread spins on idle as long as recent idle phases suggest, then parks until a task is submitted" );
+   cfg.registerArgOption( "enable-adaptive-idle", "enable-adaptive-idle" );
+
+   std::ostringstream spin_sstream;
+   spin_sstream << "Set the maximum amount of time (in nsec) an adaptive idle thread spins (default = "
+      << DEFAULT_MAX_SPIN_NS << ")";
+   cfg.registerConfigOption ( "adaptive-max-spin-time", NEW Config::UintVar( _maxSpinTime ), spin_sstream.str() );
+   cfg.registerArgOption ( "adaptive-max-spin-time", "adaptive-max-spin-time" );
+
    cfg.registerConfigOption( "enable-dlb", NEW Config::FlagOption ( _useDLB ),
          "Tune Nanos Runtime to be used with Dynamic Load Balancing library" );
    cfg.registerArgOption( "enable-dlb", "enable-dlb" );
@@ -508,6 +632,11 @@ ThreadManager* ThreadManagerConf::create()
       _useSleep = false;
    }
 
+   if ( _useSleep && _useAdaptive ) {
+      warning0( "Option --enable-sleep is not compatible with --enable-adaptive-idle, disabling option." );
+      _useSleep = false;
+   }
+
    return NEW ThreadManager( _warmupThreads, _forceTieMaster, _numYields,
-         _sleepTime, _useSleep, _useBlock, _useDLB );
+         _sleepTime, _useSleep, _useBlock, _useDLB, _useAdaptive, _maxSpinTime );
 }
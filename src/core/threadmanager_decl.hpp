@@ -27,6 +27,37 @@
 
 namespace nanos {
 
+//! AdaptiveIdle class
+/*!
+   * Per thread history of idle phase lengths, used by the adaptive idle policy.
+   *
+   * Lengths are kept in a decaying log2 histogram (in nanoseconds). While most
+   * of the recent idle phases were short, the thread keeps spinning for as long
+   * as it takes to cover them; when most phases were long the thread stops
+   * spinning early and parks until a task is submitted.
+   */
+class AdaptiveIdle
+{
+   private:
+      static const unsigned int NUM_BUCKETS = 32;   //!< Bucket i holds phases of [2^i, 2^(i+1)) ns
+      static const unsigned int DECAY_PERIOD = 64;  //!< Samples before the histogram is halved
+
+      unsigned int         _histogram[NUM_BUCKETS];
+      unsigned int         _samples;
+      double               _maxSpinTime;     //!< Idle phases longer than this (in sec) are never spun
+      double               _spinTime;        //!< Current spin time (in sec)
+
+      void update();
+   public:
+      AdaptiveIdle( unsigned int max_spin_ns );
+
+      //! \brief Records the length (in sec) of an idle phase that ended finding work
+      void record( double length );
+
+      //! \brief Returns whether a thread idle for elapsed sec should go on spinning
+      bool keepSpinning( double elapsed ) const { return elapsed < _spinTime; }
+};
+
 class ThreadManager
 {
    private:
@@ -42,11 +73,16 @@ class ThreadManager
       bool              _useSleep;
       bool              _useBlock;
       bool              _useDLB;
+      bool              _useAdaptive;
+      unsigned int      _maxSpinTime;
+      Atomic<int>       _parkedThreads;
+      Atomic<int>       _parkSequence;       /* Futex word parked threads sleep on */
       std::deque<int>   _self_managed_cpus;  /* List of CPUs lent while DLB is disabled */
 
    public:
       ThreadManager( bool warmup, bool tie_master, unsigned int num_yields,
-            unsigned int sleep_time, bool use_sleep, bool use_block, bool use_dlb );
+            unsigned int sleep_time, bool use_sleep, bool use_block, bool use_dlb,
+            bool use_adaptive, unsigned int max_spin_time );
 
       ~ThreadManager();
 
@@ -61,6 +97,10 @@ class ThreadManager
             );
       void blockThread( BaseThread *thread );
       void unblockThread( BaseThread *thread );
+      void parkThread( BaseThread *thread );
+      void wakeUpParked( int num = 1 );
+      bool isAdaptive() const { return _useAdaptive; }
+      unsigned int getMaxSpinTime() const { return _maxSpinTime; }
       void lendCpu( BaseThread *thread );
       void acquireOne();
       void acquireDefaultCPUs( int max );
@@ -88,12 +128,16 @@ class ThreadManagerConf
       bool                 _useSleep;        //!< Sleep is enabled
       bool                 _useBlock;        //!< Block is enabled
       bool                 _useDLB;          //!< DLB library will be used
+      bool                 _useAdaptive;     //!< Adaptive spin, then park on idle
+      unsigned int         _maxSpinTime;     //!< Maximum number of nanoseconds an adaptive thread spins
       bool                 _forceTieMaster;  //!< Force Master WD (user code) to run on Master Thread
       bool                 _warmupThreads;   //!< Force the initialization of as many threads as number of CPUs, then block them if needed
 
    public:
       static const unsigned int DEFAULT_SLEEP_NS;
       static const unsigned int DEFAULT_YIELDS;
+      static const unsigned int DEFAULT_MAX_SPIN_NS;
+      static const unsigned int DEFAULT_PARK_NS;
 
       ThreadManagerConf();
       unsigned int getNumYields ( void ) const { return _numYields; }
@@ -22,6 +22,8 @@
 #include "threadteam_decl.hpp"
 #include "atomic.hpp"
 #include "lock.hpp"
+#include "ticketlock.hpp"
+#include "mcslock.hpp"
 #include "debug.hpp"
 #include "system.hpp"
 #include "task_reduction.hpp"
@@ -119,7 +121,7 @@ inline unsigned ThreadTeam::addThread ( BaseThread *thread, bool star, bool crea
 {
    unsigned id;
    {
-      LockBlock Lock( _lock );
+      GenericLockBlock<TeamLock> Lock( _lock );
       for ( id = 0; id < _idList.size(); id++) if ( _idList[id] == false ) break;
       _threads[id] = thread;
       _idList[id] = true;
@@ -135,7 +137,7 @@ inline unsigned ThreadTeam::addThread ( BaseThread *thread, bool star, bool crea
 
 inline size_t ThreadTeam::removeThread ( unsigned id )
 {
-   LockBlock Lock( _lock );
+   GenericLockBlock<TeamLock> Lock( _lock );
    _threads.erase( id );
    _idList[id] = false;
    return ( _threads.size() );
@@ -146,7 +148,7 @@ inline BaseThread * ThreadTeam::popThread ( )
    BaseThread * thread;
    {
       // \todo It will be better to use _threads/_idList[] idiom
-      LockBlock Lock( _lock );
+      GenericLockBlock<TeamLock> Lock( _lock );
       ThreadTeamList::iterator last = _threads.end();
       ThreadTeamIdList::iterator lastId = _idList.end();
       --last;
@@ -259,6 +261,32 @@ inline void ThreadTeam::computeVectorReductions ( void )
    }
 }
 
+inline void ThreadTeam::combineVectorReductions ( unsigned int target, unsigned int source )
+{
+   nanos_reduction_t *red;
+   ReductionList::iterator it;
+   for ( it = _redList.begin(); it != _redList.end(); it++) {
+      red = *it;
+      if ( red->vop ) continue;
+      char *privates = reinterpret_cast<char*>(red->privates);
+      red->bop( privates + target * red->element_size, privates + source * red->element_size, red->num_scalars );
+   }
+}
+
+inline void ThreadTeam::finishVectorReductions ( void )
+{
+   nanos_reduction_t *red;
+   ReductionList::iterator it;
+   for ( it = _redList.begin(); it != _redList.end(); it++) {
+      red = *it;
+      if ( red->vop ) {
+         red->vop( this->size(), red->original, red->privates );
+      } else {
+         red->bop( red->original, red->privates, red->num_scalars );
+      }
+   }
+}
+
 inline void *ThreadTeam::getReductionPrivateData ( void* s )
 {
    ReductionList::iterator it;
@@ -282,14 +310,14 @@ inline size_t ThreadTeam::getFinalSize ( void ) const { return _expectedThreads.
 
 inline void ThreadTeam::addExpectedThread( BaseThread *thread )
 {
-   LockBlock Lock( _lock );
+   GenericLockBlock<TeamLock> Lock( _lock );
    _expectedThreads.insert( thread );
    _barrier.resize( _expectedThreads.size() );
 }
 
 inline void ThreadTeam::removeExpectedThread( BaseThread *thread )
 {
-   LockBlock Lock( _lock );
+   GenericLockBlock<TeamLock> Lock( _lock );
    _expectedThreads.erase( thread );
    _barrier.resize( _expectedThreads.size() );
 }
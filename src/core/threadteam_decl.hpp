@@ -26,6 +26,14 @@
 #include "schedule_decl.hpp"
 #include "barrier_decl.hpp"
 #include "task_reduction_decl.hpp"
+#include "lock_decl.hpp"
+#include "ticketlock_decl.hpp"
+#include "mcslock_decl.hpp"
+
+/*! Lock of the team membership, can be set at build time to TicketLock or McsLock */
+#ifndef NANOS_TEAM_LOCK
+#define NANOS_TEAM_LOCK Lock
+#endif
 
 
 namespace nanos {
@@ -58,6 +66,7 @@ namespace nanos {
          typedef std::map<unsigned, bool>          ThreadTeamIdList; /**< List of team members */
          typedef std::list<TaskReduction *>        task_reduction_list_t;  //< List of task reductions type
          typedef std::set<BaseThread *>            ThreadSet;
+         typedef NANOS_TEAM_LOCK                   TeamLock;
 
          ThreadTeamList               _threads;          /**< Threads that make up the team */
          ThreadTeamIdList             _idList;           /**< List of id usage (reusing old id's) */
@@ -79,7 +88,7 @@ namespace nanos {
          int                          _creatorId;        /**< Team Id of the thread that created the team */
          nanos_ws_desc_t             *_wsDescriptor;     /**< Worksharing queue (pointer managed due specific atomic op's over these pointers) */
          ReductionList                _redList;          /**< Reduction List */
-         Lock                         _lock;
+         TeamLock                     _lock;
       private:
 
          /*! \brief ThreadTeam default constructor (disabled)
@@ -213,6 +222,18 @@ namespace nanos {
          */
          void computeVectorReductions ( void );
 
+        /*! \brief Folds the private copies of member source into the ones of member target
+         *
+         *  Only the reductions with an element-wise operation (bop) are folded, the ones with
+         *  a vector operation (vop) are left untouched for finishVectorReductions.
+         */
+         void combineVectorReductions ( unsigned int target, unsigned int source );
+
+        /*! \brief Compute reductions whose private copies have already been folded into member 0
+         *  \see combineVectorReductions
+         */
+         void finishVectorReductions ( void );
+
         /*! \brief Get final size
          */
          size_t getFinalSize ( void ) const;
@@ -20,6 +20,10 @@
 #ifndef __NANOS_THROTTLE_POLICY_DECL_H
 #define __NANOS_THROTTLE_POLICY_DECL_H
 
+#include <stddef.h>
+#include "workdescriptor_fwd.hpp"
+#include "dataaccess_fwd.hpp"
+
 namespace nanos {
    class ThrottlePolicy
    {
@@ -40,6 +44,13 @@ namespace nanos {
 
          virtual bool throttleIn( void )  = 0 ;
          virtual void throttleOut( void ) { /* empty function */ }
+
+         /*! \brief Called when a WD is submitted along with its data accesses
+          */
+         virtual void throttleSubmit( WD &wd, size_t numDataAccesses, DataAccess *dataAccesses ) { /* empty function */ }
+         /*! \brief Called when a WD finishes, before throttleOut
+          */
+         virtual void throttleFinish( WD &wd ) { /* empty function */ }
    };
 } // namespace nanos
 
@@ -57,8 +57,8 @@ inline void WDDeque::push_front ( WorkDescriptor *wd )
       LockBlock lock( _lock );
       _dq.push_front( wd );
       increaseDeviceCounter( wd );
-      int tasks = ++( sys.getSchedulerStats()._readyTasks );
-      increaseTasksInQueues(tasks);
+      ++( sys.getSchedulerStats()._readyTasks );
+      increaseTasksInQueues();
       memoryFence();
    }
 }
@@ -70,8 +70,8 @@ inline void WDDeque::push_back ( WorkDescriptor *wd )
       LockBlock lock( _lock );
       _dq.push_back( wd );
       increaseDeviceCounter( wd );
-      int tasks = ++( sys.getSchedulerStats()._readyTasks );
-      increaseTasksInQueues(tasks);
+      ++( sys.getSchedulerStats()._readyTasks );
+      increaseTasksInQueues();
       memoryFence();
    }
 }
@@ -91,8 +91,8 @@ inline void WDDeque::push_front( WD** wds, size_t numElems )
       _dq.push_front( wd );
       increaseDeviceCounter( wd );
    }
-   int tasks = sys.getSchedulerStats()._readyTasks += numElems;
-   increaseTasksInQueues(tasks,numElems);
+   sys.getSchedulerStats()._readyTasks += numElems;
+   increaseTasksInQueues(numElems);
 }
 
 inline void WDDeque::push_back( WD** wds, size_t numElems )
@@ -105,8 +105,8 @@ inline void WDDeque::push_back( WD** wds, size_t numElems )
       _dq.push_back( wd );
       increaseDeviceCounter( wd );
    }
-   int tasks = sys.getSchedulerStats()._readyTasks += numElems;
-   increaseTasksInQueues(tasks,numElems);
+   sys.getSchedulerStats()._readyTasks += numElems;
+   increaseTasksInQueues(numElems);
 }
 
 struct NoConstraints
@@ -175,8 +175,8 @@ inline WorkDescriptor * WDDeque::popFrontWithConstraints ( BaseThread const *thr
                if ( wd.dequeue( &found ) ) {
                    _dq.erase( it );
                    decreaseDeviceCounter( found );
-                   int tasks = --(sys.getSchedulerStats()._readyTasks);
-                   decreaseTasksInQueues(tasks);
+                   --(sys.getSchedulerStats()._readyTasks);
+                   decreaseTasksInQueues();
                }
                break;
             }
@@ -254,8 +254,8 @@ inline WorkDescriptor * WDDeque::popBackWithConstraints ( BaseThread const *thre
                if ( wd.dequeue( &found ) ) {
                   _dq.erase( ( ++rit ).base() );
                   decreaseDeviceCounter( found );
-                  int tasks = --(sys.getSchedulerStats()._readyTasks);
-                  decreaseTasksInQueues(tasks);
+                  --(sys.getSchedulerStats()._readyTasks);
+                  decreaseTasksInQueues();
                }
                break;
             }
@@ -292,8 +292,8 @@ inline bool WDDeque::removeWDWithConstraints( BaseThread *thread, WorkDescriptor
                if ( ( *it )->dequeue( next ) ) {
                   _dq.erase( it );
                   decreaseDeviceCounter( *next );
-                  int tasks = --(sys.getSchedulerStats()._readyTasks);
-                  decreaseTasksInQueues(tasks);
+                  --(sys.getSchedulerStats()._readyTasks);
+                  decreaseTasksInQueues();
                }
                (*next)->setMyQueue( NULL );
                return true;
@@ -305,18 +305,18 @@ inline bool WDDeque::removeWDWithConstraints( BaseThread *thread, WorkDescriptor
    return false;
 }
 
-inline void WDDeque::increaseTasksInQueues( int tasks, int increment )
+inline void WDDeque::increaseTasksInQueues( int increment )
 {
    NANOS_INSTRUMENT(static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("num-ready");)
-   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) tasks );
+   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) sys.getSchedulerStats().getReadyTasks() );
    NANOS_INSTRUMENT(sys.getInstrumentation()->raisePointEvents(1, &key, &nb );)
    _nelems += increment;
 }
 
-inline void WDDeque::decreaseTasksInQueues( int tasks, int decrement )
+inline void WDDeque::decreaseTasksInQueues( int decrement )
 {
    NANOS_INSTRUMENT(static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("num-ready");)
-   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) tasks );
+   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) sys.getSchedulerStats().getReadyTasks() );
    NANOS_INSTRUMENT(sys.getInstrumentation()->raisePointEvents(1, &key, &nb );)
    _nelems -= decrement;
 }
@@ -507,7 +507,7 @@ inline WorkDescriptor * WDLFQueue::pop_front ( BaseThread *thread )
                                  (void *) head,
                                  (void *) NANOS_ABA_COMPOSE(next,head)) ) { // Try to swing _head to next node
               /*int tasks =*/ --(sys.getSchedulerStats()._readyTasks);
-              //decreaseTasksInQueues(tasks);
+              //decreaseTasksInQueues();
               if ( Scheduler::checkBasicConstraints( *wd, *thread) /* && Constraints::check(wd,*thread) FIXME*/ ) {
                  if ( !wd->dequeue( &swd ) ) {
                     NANOS_ABA_PTR(head)->setWD(wd);
@@ -538,6 +538,209 @@ inline bool WDLFQueue::removeWD( BaseThread *thread, WorkDescriptor *toRem, Work
    return false;
 }
 
+/***********************
+ * WDWorkStealingDeque *
+ ***********************/
+
+inline WDWorkStealingDeque::WDArray * WDWorkStealingDeque::WDArray::grow ( long bottom, long top )
+{
+   WDArray *array = NEW WDArray( capacity() * 2, this );
+   for ( long i = top; i < bottom; i++ ) {
+      array->put( i, get( i ) );
+   }
+   return array;
+}
+
+inline WDWorkStealingDeque::WDWorkStealingDeque( size_t capacity ) : _top( 0 ), _bottom( 0 ), _array( NULL ), _lock()
+{
+   long slots = 1;
+   while ( slots < (long) capacity ) slots <<= 1;
+   _array = NEW WDArray( slots, NULL );
+}
+
+inline bool WDWorkStealingDeque::empty ( void ) const
+{
+   return _bottom.value() <= _top.value();
+}
+
+inline size_t WDWorkStealingDeque::size() const
+{
+   long elems = _bottom.value() - _top.value();
+   return elems > 0 ? (size_t) elems : 0;
+}
+
+inline void WDWorkStealingDeque::pushBottom ( WorkDescriptor *wd )
+{
+   long bottom = _bottom.value();
+   long top = _top.value();
+   WDArray *array = _array;
+
+   if ( bottom - top >= array->capacity() ) {
+      array = array->grow( bottom, top );
+      _array = array;
+   }
+   array->put( bottom, wd );
+   memoryFence();
+   _bottom = bottom + 1;
+}
+
+inline WorkDescriptor * WDWorkStealingDeque::popBottom ( void )
+{
+   long bottom = _bottom.value() - 1;
+   WDArray *array = _array;
+   _bottom = bottom;
+   memoryFence();
+   long top = _top.value();
+
+   if ( top > bottom ) {
+      // Empty deque
+      _bottom = bottom + 1;
+      return NULL;
+   }
+
+   WorkDescriptor *wd = array->get( bottom );
+   if ( top == bottom ) {
+      // Last element, race against thieves for it
+      if ( !_top.cswap( top, top + 1 ) ) wd = NULL;
+      _bottom = bottom + 1;
+   }
+   return wd;
+}
+
+inline WorkDescriptor * WDWorkStealingDeque::steal ( void )
+{
+   long top = _top.value();
+   memoryFence();
+   long bottom = _bottom.value();
+
+   if ( top >= bottom ) return NULL;
+
+   WorkDescriptor *wd = _array->get( top );
+   if ( !_top.cswap( top, top + 1 ) ) return NULL;
+   return wd;
+}
+
+inline WorkDescriptor * WDWorkStealingDeque::claim ( BaseThread *thread, WorkDescriptor *wd )
+{
+   WorkDescriptor *found = NULL;
+
+   if ( !Scheduler::checkBasicConstraints( *wd, *thread ) ) {
+      pushBottom( wd );
+      return NULL;
+   }
+
+   if ( wd->dequeue( &found ) ) {
+      --(sys.getSchedulerStats()._readyTasks);
+      decreaseTasksInQueues();
+   } else {
+      // Only a slice was dequeued, the WD remains in the deque
+      pushBottom( wd );
+   }
+
+   if ( found != NULL ) found->setMyQueue( NULL );
+
+   ensure( !found || !found->isTied() || found->isTiedTo() == thread, "" );
+
+   return found;
+}
+
+inline void WDWorkStealingDeque::push_front ( WorkDescriptor *wd )
+{
+   wd->setMyQueue( this );
+   ++( sys.getSchedulerStats()._readyTasks );
+   {
+      LockBlock lock( _lock );
+      pushBottom( wd );
+   }
+   increaseTasksInQueues();
+}
+
+inline void WDWorkStealingDeque::push_back ( WorkDescriptor *wd )
+{
+   fatal0("Calling push_back method is not allowed using WDWorkStealingDeque's");
+}
+
+inline Lock& WDWorkStealingDeque::getLock()
+{
+   return _lock;
+}
+
+inline void WDWorkStealingDeque::push_front( WD** wds, size_t numElems )
+{
+   sys.getSchedulerStats()._readyTasks += numElems;
+   {
+      LockBlock lock( _lock );
+      for( size_t i = 0; i < numElems; ++i )
+      {
+         wds[i]->setMyQueue( this );
+         pushBottom( wds[i] );
+      }
+   }
+   increaseTasksInQueues();
+}
+
+inline void WDWorkStealingDeque::push_back( WD** wds, size_t numElems )
+{
+   fatal0("Calling push_back method is not allowed using WDWorkStealingDeque's");
+}
+
+inline WorkDescriptor * WDWorkStealingDeque::pop_front ( BaseThread *thread )
+{
+   if ( empty() ) return NULL;
+
+   LockBlock lock( _lock );
+   WorkDescriptor *wd = popBottom();
+   return wd != NULL ? claim( thread, wd ) : NULL;
+}
+
+inline WorkDescriptor * WDWorkStealingDeque::pop_back ( BaseThread *thread )
+{
+   if ( empty() ) return NULL;
+
+   WorkDescriptor *wd = steal();
+   if ( wd == NULL ) return NULL;
+
+   // Constraints are rarely rejected, the front end lock is only needed to give the WD back
+   if ( Scheduler::checkBasicConstraints( *wd, *thread ) ) {
+      WorkDescriptor *found = NULL;
+      if ( wd->dequeue( &found ) ) {
+         --(sys.getSchedulerStats()._readyTasks);
+         decreaseTasksInQueues();
+         found->setMyQueue( NULL );
+         ensure( !found->isTied() || found->isTiedTo() == thread, "" );
+         return found;
+      }
+      LockBlock lock( _lock );
+      pushBottom( wd );
+      if ( found != NULL ) found->setMyQueue( NULL );
+      return found;
+   }
+
+   LockBlock lock( _lock );
+   pushBottom( wd );
+   return NULL;
+}
+
+inline bool WDWorkStealingDeque::removeWD( BaseThread *thread, WorkDescriptor *toRem, WorkDescriptor **next )
+{
+   // Elements can only leave the deque through its ends
+   return false;
+}
+
+inline void WDWorkStealingDeque::increaseTasksInQueues()
+{
+   NANOS_INSTRUMENT(static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("num-ready");)
+   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) sys.getSchedulerStats().getReadyTasks() );
+   NANOS_INSTRUMENT(sys.getInstrumentation()->raisePointEvents(1, &key, &nb );)
+}
+
+inline void WDWorkStealingDeque::decreaseTasksInQueues()
+{
+   NANOS_INSTRUMENT(static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("num-ready");)
+   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) sys.getSchedulerStats().getReadyTasks() );
+   NANOS_INSTRUMENT(sys.getInstrumentation()->raisePointEvents(1, &key, &nb );)
+}
+
 template <typename T>
 inline WDPriorityQueue<T>::WDPriorityQueue( bool enableDeviceCounter, bool optimise, bool reverse, PriorityValueFun getter )
    : _dq(), _lock(), _nelems(0), _optimise( optimise ), _reverse( reverse ), _ndevs(), _deviceCounter( enableDeviceCounter ),
@@ -660,8 +863,8 @@ inline void WDPriorityQueue<T>::push_back ( WorkDescriptor *wd )
       LockBlock lock( _lock );
       insertOrdered( wd, true );
       increaseDeviceCounter( wd );
-      int tasks = ++( sys.getSchedulerStats()._readyTasks );
-      increaseTasksInQueues(tasks);
+      ++( sys.getSchedulerStats()._readyTasks );
+      increaseTasksInQueues();
       memoryFence();
    }
 }
@@ -678,8 +881,8 @@ inline void WDPriorityQueue<T>::push_front ( WorkDescriptor *wd )
       LockBlock lock( _lock );
       insertOrdered( wd, false );
       increaseDeviceCounter( wd );
-      int tasks = ++( sys.getSchedulerStats()._readyTasks );
-      increaseTasksInQueues(tasks);
+      ++( sys.getSchedulerStats()._readyTasks );
+      increaseTasksInQueues();
       memoryFence();
    }
 }
@@ -722,8 +925,8 @@ inline void WDPriorityQueue<T>::push_front( WD** wds, size_t numElems )
       insertOrdered( wd, false );
       increaseDeviceCounter( wd );
    }
-   int tasks = sys.getSchedulerStats()._readyTasks += numElems;
-   increaseTasksInQueues(tasks,numElems);
+   sys.getSchedulerStats()._readyTasks += numElems;
+   increaseTasksInQueues(numElems);
    fatal_cond( _dq.size() != _nelems, "List size does not match queue size" );
 }
 
@@ -763,8 +966,8 @@ inline void WDPriorityQueue<T>::push_back( WD** wds, size_t numElems )
       increaseDeviceCounter( wd );
 
    }*/
-   int tasks = sys.getSchedulerStats()._readyTasks += numElems;
-   increaseTasksInQueues(tasks,numElems);
+   sys.getSchedulerStats()._readyTasks += numElems;
+   increaseTasksInQueues(numElems);
    fatal_cond( _dq.size() != _nelems, "List size does not match queue size" );
 }
 
@@ -810,8 +1013,8 @@ inline WorkDescriptor * WDPriorityQueue<T>::popFrontWithConstraints ( BaseThread
                      _maxPriority = _dq.front()->getPriority();
                      _minPriority = _dq.back()->getPriority();
                   }
-                  int tasks = --(sys.getSchedulerStats()._readyTasks);
-                  decreaseTasksInQueues(tasks);
+                  --(sys.getSchedulerStats()._readyTasks);
+                  decreaseTasksInQueues();
                }
                break;
             }
@@ -861,8 +1064,8 @@ inline WorkDescriptor * WDPriorityQueue<T>::popBackWithConstraints ( BaseThread
                      _maxPriority = _dq.front()->getPriority();
                      _minPriority = _dq.back()->getPriority();
                   }
-                  int tasks = --(sys.getSchedulerStats()._readyTasks);
-                  decreaseTasksInQueues(tasks);
+                  --(sys.getSchedulerStats()._readyTasks);
+                  decreaseTasksInQueues();
                }
                break;
             }
@@ -900,8 +1103,8 @@ inline bool WDPriorityQueue<T>::removeWDWithConstraints( BaseThread *thread, Wor
                if ( ( *it )->dequeue( next ) ) {
                   _dq.erase( it );
                   decreaseDeviceCounter( *next );
-                  int tasks = --(sys.getSchedulerStats()._readyTasks);
-                  decreaseTasksInQueues(tasks);
+                  --(sys.getSchedulerStats()._readyTasks);
+                  decreaseTasksInQueues();
                }
                (*next)->setMyQueue( NULL );
                return true;
@@ -947,20 +1150,20 @@ inline WD::PriorityType WDPriorityQueue<T>::minPriority() const
 }
 
 template<typename T>
-inline void WDPriorityQueue<T>::increaseTasksInQueues( int tasks, int increment )
+inline void WDPriorityQueue<T>::increaseTasksInQueues( int increment )
 {
    NANOS_INSTRUMENT(static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("num-ready");)
-   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) tasks );
+   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) sys.getSchedulerStats().getReadyTasks() );
    NANOS_INSTRUMENT(sys.getInstrumentation()->raisePointEvents(1, &key, &nb );)
    _nelems += increment;
    fatal_cond( _dq.size() != _nelems, "List size does not match queue size (increase)" );
 }
 
 template<typename T>
-inline void WDPriorityQueue<T>::decreaseTasksInQueues( int tasks, int decrement )
+inline void WDPriorityQueue<T>::decreaseTasksInQueues( int decrement )
 {
    NANOS_INSTRUMENT(static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("num-ready");)
-   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) tasks );
+   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) sys.getSchedulerStats().getReadyTasks() );
    NANOS_INSTRUMENT(sys.getInstrumentation()->raisePointEvents(1, &key, &nb );)
    _nelems -= decrement;
    fatal_cond( _dq.size() != _nelems, "List size does not match queue size (decrease)" );
@@ -1018,6 +1221,409 @@ inline bool WDPriorityQueue<T>::testDequeue()
    return wd_avail;
 }
 
+template <typename T>
+inline WDHeapPriorityQueue<T>::WDHeapPriorityQueue( bool enableDeviceCounter, bool reverse, PriorityValueFun getter )
+   : _heap(), _candidates(), _lock(), _nelems(0), _backSeq( 0 ), _frontSeq( 0 ), _reverse( reverse ), _ndevs(),
+     _deviceCounter( enableDeviceCounter ), _getter( getter ), _maxPriority( 0 ), _minPriority( 0 )
+{
+   if ( _deviceCounter ) {
+      const DeviceList &devs = sys.getSupportedDevices();
+      for ( DeviceList::const_iterator it = devs.begin(); it != devs.end(); ++it ) {
+         _ndevs.insert( std::make_pair<const Device*, Atomic<unsigned int> >( *it, 0 ) );
+      }
+   }
+}
+
+template<typename T>
+inline bool WDHeapPriorityQueue<T>::empty ( void ) const
+{
+   return _heap.empty();
+}
+
+template<typename T>
+inline size_t WDHeapPriorityQueue<T>::size() const
+{
+   return _nelems;
+}
+
+template<typename T>
+inline bool WDHeapPriorityQueue<T>::before ( const Entry &a, const Entry &b ) const
+{
+   if ( a._key != b._key ) return _reverse ? a._key < b._key : a._key > b._key;
+   return a._seq < b._seq;
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::siftUp ( size_t pos )
+{
+   Entry e = _heap[pos];
+   while ( pos > 0 ) {
+      size_t parent = ( pos - 1 ) / 2;
+      if ( !before( e, _heap[parent] ) ) break;
+      _heap[pos] = _heap[parent];
+      pos = parent;
+   }
+   _heap[pos] = e;
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::siftDown ( size_t pos )
+{
+   Entry e = _heap[pos];
+   size_t n = _heap.size();
+   while ( 2 * pos + 1 < n ) {
+      size_t child = 2 * pos + 1;
+      if ( child + 1 < n && before( _heap[child + 1], _heap[child] ) ) child++;
+      if ( !before( _heap[child], e ) ) break;
+      _heap[pos] = _heap[child];
+      pos = child;
+   }
+   _heap[pos] = e;
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::insertOrdered( WorkDescriptor *wd, bool fifo )
+{
+   Entry e;
+   e._wd = wd;
+   e._key = _getter( wd );
+   e._seq = fifo ? _backSeq++ : --_frontSeq;
+
+   WD::PriorityType priority = wd->getPriority();
+   if ( _heap.empty() || priority < _minPriority ) _minPriority = priority;
+
+   _heap.push_back( e );
+   siftUp( _heap.size() - 1 );
+
+   _maxPriority = _heap.front()._wd->getPriority();
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::removeAt ( size_t pos )
+{
+   size_t last = _heap.size() - 1;
+   if ( pos != last ) {
+      _heap[pos] = _heap[last];
+      _heap.pop_back();
+      // The moved element may need to go either way
+      if ( pos > 0 && before( _heap[pos], _heap[( pos - 1 ) / 2] ) ) siftUp( pos );
+      else siftDown( pos );
+   } else {
+      _heap.pop_back();
+   }
+}
+
+template<typename T>
+inline size_t WDHeapPriorityQueue<T>::find ( const WorkDescriptor *wd ) const
+{
+   size_t pos;
+   for ( pos = 0; pos < _heap.size(); pos++ ) {
+      if ( _heap[pos]._wd == wd ) break;
+   }
+   return pos;
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::updatePriorities ()
+{
+   if ( _heap.empty() ) {
+      _maxPriority = 0;
+      _minPriority = 0;
+      // Sequence numbers can start again
+      _backSeq = 0;
+      _frontSeq = 0;
+   } else {
+      _maxPriority = _heap.front()._wd->getPriority();
+   }
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::push_back ( WorkDescriptor *wd )
+{
+   wd->setMyQueue( this );
+   {
+      LockBlock lock( _lock );
+      insertOrdered( wd, true );
+      increaseDeviceCounter( wd );
+      ++( sys.getSchedulerStats()._readyTasks );
+      increaseTasksInQueues();
+      memoryFence();
+   }
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::push_front ( WorkDescriptor *wd )
+{
+   wd->setMyQueue( this );
+   {
+      LockBlock lock( _lock );
+      insertOrdered( wd, false );
+      increaseDeviceCounter( wd );
+      ++( sys.getSchedulerStats()._readyTasks );
+      increaseTasksInQueues();
+      memoryFence();
+   }
+}
+
+template<typename T>
+inline WorkDescriptor * WDHeapPriorityQueue<T>::pop_back ( BaseThread *thread )
+{
+   return popBackWithConstraints<NoConstraints>(thread);
+}
+
+template<typename T>
+inline WorkDescriptor * WDHeapPriorityQueue<T>::pop_front ( BaseThread *thread )
+{
+   return popFrontWithConstraints<NoConstraints>(thread);
+}
+
+template<typename T>
+inline Lock& WDHeapPriorityQueue<T>::getLock()
+{
+   return _lock;
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::push_front( WD** wds, size_t numElems )
+{
+   LockBlock lock( _lock );
+   for( size_t i = 0; i < numElems; ++i )
+   {
+      WD* wd = wds[i];
+      wd->setMyQueue( this );
+      insertOrdered( wd, false );
+      increaseDeviceCounter( wd );
+   }
+   sys.getSchedulerStats()._readyTasks += numElems;
+   increaseTasksInQueues(numElems);
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::push_back( WD** wds, size_t numElems )
+{
+   LockBlock lock( _lock );
+   fatal_cond( numElems == 0, "No reason to call push_back for 0 elements" );
+   for( size_t i = 0; i < numElems; ++i )
+   {
+      WD* wd = wds[i];
+      wd->setMyQueue( this );
+      insertOrdered( wd, true );
+      increaseDeviceCounter( wd );
+   }
+   sys.getSchedulerStats()._readyTasks += numElems;
+   increaseTasksInQueues(numElems);
+}
+
+template<typename T>
+inline bool WDHeapPriorityQueue<T>::removeWD( BaseThread *thread, WorkDescriptor *toRem, WorkDescriptor **next )
+{
+   return removeWDWithConstraints<NoConstraints>(thread,toRem,next);
+}
+
+template <typename T>
+template <typename Constraints>
+inline WorkDescriptor * WDHeapPriorityQueue<T>::popWithConstraints ( BaseThread *thread )
+{
+   WorkDescriptor *found = NULL;
+
+   if ( _heap.empty() )
+      return NULL;
+   {
+      LockBlock lock( _lock );
+
+      memoryFence();
+
+      if ( !_heap.empty() ) {
+         // Visit the heap in priority order: a position is only reached
+         // after its parent has been rejected
+         _candidates.clear();
+         _candidates.push_back( 0 );
+         while ( !_candidates.empty() ) {
+            size_t best = 0;
+            for ( size_t i = 1; i < _candidates.size(); i++ ) {
+               if ( before( _heap[_candidates[i]], _heap[_candidates[best]] ) ) best = i;
+            }
+            size_t pos = _candidates[best];
+            _candidates[best] = _candidates.back();
+            _candidates.pop_back();
+
+            WD &wd = *_heap[pos]._wd;
+            if ( Scheduler::checkBasicConstraints( wd, *thread) && Constraints::check(wd,*thread)) {
+               if ( wd.dequeue( &found ) ) {
+                  removeAt( pos );
+                  decreaseDeviceCounter( found );
+                  updatePriorities();
+                  --(sys.getSchedulerStats()._readyTasks);
+                  decreaseTasksInQueues();
+               }
+               break;
+            }
+
+            if ( 2 * pos + 1 < _heap.size() ) _candidates.push_back( 2 * pos + 1 );
+            if ( 2 * pos + 2 < _heap.size() ) _candidates.push_back( 2 * pos + 2 );
+         }
+      }
+
+      if ( found != NULL ) found->setMyQueue( NULL );
+   }
+
+   ensure( !found || !found->isTied() || found->isTiedTo() == thread, "" );
+
+   return found;
+}
+
+template <typename T>
+template <typename Constraints>
+inline WorkDescriptor * WDHeapPriorityQueue<T>::popFrontWithConstraints ( BaseThread *thread )
+{
+   return popWithConstraints<Constraints>( thread );
+}
+
+/*!
+ * \note As in WDPriorityQueue, the back of a priority queue is its front.
+ */
+template <typename T>
+template <typename Constraints>
+inline WorkDescriptor * WDHeapPriorityQueue<T>::popBackWithConstraints ( BaseThread *thread )
+{
+   return popWithConstraints<Constraints>( thread );
+}
+
+template <typename T>
+template <typename Constraints>
+inline bool WDHeapPriorityQueue<T>::removeWDWithConstraints( BaseThread *thread, WorkDescriptor *toRem, WorkDescriptor **next )
+{
+   if ( _heap.empty() ) return false;
+
+   if ( !Scheduler::checkBasicConstraints( *toRem, *thread) || !Constraints::check(*toRem, *thread) ) return false;
+
+   *next = NULL;
+
+   {
+      LockBlock lock( _lock );
+
+      memoryFence();
+
+      if ( !_heap.empty() && toRem->getMyQueue() == this ) {
+         size_t pos = find( toRem );
+         if ( pos != _heap.size() ) {
+            if ( toRem->dequeue( next ) ) {
+               removeAt( pos );
+               decreaseDeviceCounter( *next );
+               updatePriorities();
+               --(sys.getSchedulerStats()._readyTasks);
+               decreaseTasksInQueues();
+            }
+            (*next)->setMyQueue( NULL );
+            return true;
+         }
+      }
+   }
+
+   return false;
+}
+
+template<typename T>
+inline bool WDHeapPriorityQueue<T>::reorderWD( WorkDescriptor *wd )
+{
+   LockBlock l( _lock );
+
+   size_t pos = find( wd );
+
+   // If the WD was not found, return false
+   if ( pos == _heap.size() ) {
+      return false;
+   }
+
+   // Otherwise, reorder it
+   removeAt( pos );
+   insertOrdered( wd );
+
+   return true;
+}
+
+template<typename T>
+inline WD::PriorityType WDHeapPriorityQueue<T>::maxPriority() const
+{
+   return _maxPriority;
+}
+
+template<typename T>
+inline WD::PriorityType WDHeapPriorityQueue<T>::minPriority() const
+{
+   return _minPriority;
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::increaseTasksInQueues( int increment )
+{
+   NANOS_INSTRUMENT(static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("num-ready");)
+   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) sys.getSchedulerStats().getReadyTasks() );
+   NANOS_INSTRUMENT(sys.getInstrumentation()->raisePointEvents(1, &key, &nb );)
+   _nelems += increment;
+   ensure( _heap.size() == _nelems, "Heap size does not match queue size (increase)" );
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::decreaseTasksInQueues( int decrement )
+{
+   NANOS_INSTRUMENT(static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("num-ready");)
+   NANOS_INSTRUMENT( nanos_event_value_t nb =  (nanos_event_value_t ) sys.getSchedulerStats().getReadyTasks() );
+   NANOS_INSTRUMENT(sys.getInstrumentation()->raisePointEvents(1, &key, &nb );)
+   _nelems -= decrement;
+   ensure( _heap.size() == _nelems, "Heap size does not match queue size (decrease)" );
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::increaseDeviceCounter ( WorkDescriptor *wd )
+{
+   if ( _deviceCounter ) {
+      for ( unsigned int i = 0; i < wd->getNumDevices(); i++ ) {
+         const Device *device = wd->getDevices()[i]->getDevice();
+         WDDeviceCounter::iterator device_counter = _ndevs.find( device );
+         ensure( device_counter != _ndevs.end(), "Device not initialized" );
+         ++device_counter->second;
+      }
+   }
+}
+
+template<typename T>
+inline void WDHeapPriorityQueue<T>::decreaseDeviceCounter ( WorkDescriptor *wd )
+{
+   if ( _deviceCounter ) {
+      for ( unsigned int i = 0; i < wd->getNumDevices(); i++ ) {
+         const Device *device = wd->getDevices()[i]->getDevice();
+         WDDeviceCounter::iterator device_counter = _ndevs.find( device );
+         ensure( device_counter != _ndevs.end(), "Device not initialized" );
+         --device_counter->second;
+      }
+   }
+}
+
+template<typename T>
+inline bool WDHeapPriorityQueue<T>::testDequeue()
+{
+   if ( _heap.empty() )
+      return false;
+
+   bool wd_avail = false;
+   // Skip check if there's contention in the queue
+   if ( _lock.tryAcquire() ) {
+      // Auxiliary map to count successful commutative accesses
+      std::map<WD**, WD*> comm_accesses;
+      typename BaseContainer::const_iterator it;
+      for ( it = _heap.begin(); it != _heap.end(); ++it ) {
+         if ( it->_wd->getConcurrencyLevel( comm_accesses ) > 0 ) {
+            wd_avail = true;
+            break;
+         }
+      }
+      _lock.release();
+   }
+
+   return wd_avail;
+}
+
 } // namespace nanos
 
 #endif
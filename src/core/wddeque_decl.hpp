@@ -21,12 +21,14 @@
 #define _NANOS_LIB_WDDEQUE_DECL_H
 
 #include <list>
+#include <vector>
 #include <functional>
 #include <map>
 
 #include "debug.hpp"
 #include "atomic_decl.hpp"
 #include "lock_decl.hpp"
+#include "allocator_decl.hpp"
 
 #include "basethread_fwd.hpp"
 
@@ -127,8 +129,8 @@ namespace nanos {
           */
          const WDDeque & operator= ( const WDDeque & );
 
-         void increaseTasksInQueues( int tasks, int increment = 1 );
-         void decreaseTasksInQueues( int tasks, int decrement = 1 );
+         void increaseTasksInQueues( int increment = 1 );
+         void decreaseTasksInQueues( int decrement = 1 );
 
          void increaseDeviceCounter ( WorkDescriptor *wd );
          void decreaseDeviceCounter ( WorkDescriptor *wd );
@@ -244,6 +246,107 @@ namespace nanos {
 
    };
    
+   /*! \brief Work-stealing deque of WorkDescriptors (Chase-Lev)
+    *
+    *  WDs are kept in a growable circular array indexed by two counters: the front
+    *  (bottom) end is used by the owner thread through push_front/pop_front and the
+    *  back (top) end is used by thieves through pop_back. Thieves never take a lock,
+    *  they claim the element at the back with a single CAS. Operations at the front
+    *  end are serialized by _lock, which is uncontended while only the owner queues
+    *  work into it. No list node is allocated per push: the array is doubled when it
+    *  fills up and the old ones are kept until destruction, so a thief still reading
+    *  from an outdated array is always safe.
+    *  \note Elements cannot be inserted at the back (push_back) nor removed from the
+    *  middle of the deque (removeWD).
+    */
+   class WDWorkStealingDeque : public WDPool
+   {
+      private:
+         class WDArray
+         {
+            private:
+               long              _mask;     /**< Capacity - 1 (capacity is a power of two) */
+               WorkDescriptor  **_slots;    /**< Circular storage */
+               WDArray          *_prev;     /**< Array replaced by this one, released on destruction */
+            private:
+               /*! \brief WDArray copy constructor (private)
+                */
+               WDArray ( const WDArray & );
+               /*! \brief WDArray copy assignment operator (private)
+                */
+               const WDArray & operator= ( const WDArray & );
+            public:
+               /*! \brief WDArray constructor
+                */
+               WDArray ( long capacity, WDArray *prev ) : _mask( capacity - 1 ), _slots( NEW WorkDescriptor *[capacity] ), _prev( prev ) {}
+               /*! \brief WDArray destructor
+                */
+               ~WDArray () { delete[] _slots; delete _prev; }
+
+               long capacity ( void ) const { return _mask + 1; }
+               WorkDescriptor * get ( long i ) const { return _slots[ i & _mask ]; }
+               void put ( long i, WorkDescriptor *wd ) { _slots[ i & _mask ] = wd; }
+
+               /*! \brief Returns a new array with twice the capacity holding the elements in [top,bottom)
+                */
+               WDArray * grow ( long bottom, long top );
+         };
+
+      private:
+         Atomic<long>      _top;      /**< Back (steal) end, only advanced by CAS */
+         char              _pad[NANOS_CACHELINE]; /**< Keeps thieves and owner on different cache lines */
+         Atomic<long>      _bottom;   /**< Front (owner) end */
+         WDArray * volatile _array;   /**< Current storage */
+         Lock              _lock;     /**< Serializes the operations on the front end */
+
+      private:
+         /*! \brief WDWorkStealingDeque copy constructor (private)
+          */
+         WDWorkStealingDeque ( const WDWorkStealingDeque & );
+         /*! \brief WDWorkStealingDeque copy assignment operator (private)
+          */
+         const WDWorkStealingDeque & operator= ( const WDWorkStealingDeque & );
+
+         /*! \brief Inserts a WD at the front end. _lock must be held */
+         void pushBottom ( WorkDescriptor *wd );
+         /*! \brief Removes the WD at the front end, if any. _lock must be held */
+         WorkDescriptor * popBottom ( void );
+         /*! \brief Removes the WD at the back end, if any. Lock-free */
+         WorkDescriptor * steal ( void );
+         /*! \brief Tries to dequeue a WD already removed from the deque on behalf of thread.
+          *  If the WD does not satisfy the constraints, or only a slice of it is dequeued, the WD
+          *  is inserted again at the front end. _lock must be held.
+          */
+         WorkDescriptor * claim ( BaseThread *thread, WorkDescriptor *wd );
+
+         void increaseTasksInQueues();
+         void decreaseTasksInQueues();
+
+      public:
+         /*! \brief WDWorkStealingDeque default constructor
+          *  \param capacity Initial number of slots, rounded up to a power of two
+          */
+         WDWorkStealingDeque( size_t capacity = 256 );
+         /*! \brief WDWorkStealingDeque destructor
+          */
+         ~WDWorkStealingDeque() { delete _array; }
+
+         bool empty ( void ) const;
+         size_t size() const;
+
+         void push_front ( WorkDescriptor *wd );
+         void push_back( WorkDescriptor *wd );
+
+         Lock& getLock();
+         void push_front( WD** wds, size_t numElems );
+         void push_back( WD** wds, size_t numElems );
+
+         WorkDescriptor * pop_front ( BaseThread *thread );
+         WorkDescriptor * pop_back ( BaseThread *thread );
+
+         bool removeWD( BaseThread *thread, WorkDescriptor *toRem, WorkDescriptor **next );
+   };
+
    /*! \brief Class used to compare WDs by priority.
     *  \see WDPriorityQueue::push
     */
@@ -289,6 +392,33 @@ namespace nanos {
       }
    };
 
+   /*! \brief Common interface of the WD pools ordered by priority.
+    *  \see WDPriorityQueue, WDHeapPriorityQueue
+    */
+   class WDPriorityPool : public WDPool
+   {
+      public:
+         /*! \brief WDPriorityPool default constructor
+          */
+         WDPriorityPool() : WDPool() {}
+         /*! \brief WDPriorityPool destructor
+          */
+         virtual ~WDPriorityPool() {}
+
+         /*! \brief Reorders a WD in the current queue (needed when its priority changes).
+          *  \return If the WD was found or not.
+          */
+         virtual bool reorderWD( WorkDescriptor *wd ) = 0;
+
+         /*! \brief Returns the highest priority, without blocking.
+          */
+         virtual WD::PriorityType maxPriority() const = 0;
+
+         /*! \brief Returns the lowest priority, without blocking.
+          */
+         virtual WD::PriorityType minPriority() const = 0;
+   };
+
    /*! \brief Namespace used to refer WDPriorityQueue BaseContainer.
     */
    namespace WDPQ
@@ -297,7 +427,7 @@ namespace nanos {
    }
 
    template<typename T = WD::PriorityType>
-   class WDPriorityQueue : public WDPool
+   class WDPriorityQueue : public WDPriorityPool
    {
       public:
          typedef T         type;
@@ -352,8 +482,8 @@ namespace nanos {
          WDPQ::BaseContainer::iterator lower_bound( const WD *wd );
 
 
-         void increaseTasksInQueues( int tasks, int increment = 1 );
-         void decreaseTasksInQueues( int tasks, int decrement = 1 );
+         void increaseTasksInQueues( int increment = 1 );
+         void decreaseTasksInQueues( int decrement = 1 );
 
          void increaseDeviceCounter ( WorkDescriptor *wd );
          void decreaseDeviceCounter ( WorkDescriptor *wd );
@@ -410,6 +540,150 @@ namespace nanos {
          bool testDequeue();
    };
 
+   /*! \brief Element of a WDHeapPriorityQueue.
+    */
+   template<typename T>
+   struct WDHeapEntry
+   {
+      WorkDescriptor *_wd;     /**< Queued WD */
+      T               _key;    /**< Priority (or deadline) when the WD was inserted */
+      long            _seq;    /**< Tie breaker: FIFO (increasing) or LIFO (decreasing) insertion order */
+   };
+
+   /*! \brief Priority queue based on a binary heap.
+    *
+    *  Same semantics than WDPriorityQueue (elements with the same priority
+    *  are retrieved in FIFO order when inserted with push_back and in LIFO
+    *  order when inserted with push_front), but insertion and extraction
+    *  cost O(log n) instead of the O(n) ordered insertion of the list.
+    *  Ties are broken with an insertion sequence number, so the heap keeps
+    *  the same order an ordered list would.
+    */
+   template<typename T = WD::PriorityType>
+   class WDHeapPriorityQueue : public WDPriorityPool
+   {
+      public:
+         typedef T         type;
+         typedef std::const_mem_fun_t<T, WD> PriorityValueFun;
+         typedef std::map< const Device *, Atomic<unsigned int> > WDDeviceCounter;
+         typedef WDHeapEntry<T> Entry;
+         typedef std::vector<Entry> BaseContainer;
+
+      private:
+         BaseContainer       _heap;
+         /*! \brief Heap positions pending to be visited by popWithConstraints
+          *  (kept as a member to avoid allocations, protected by _lock) */
+         std::vector<size_t> _candidates;
+         Lock                _lock;
+         size_t              _nelems;
+
+         /*! \brief Sequence numbers for push_back and push_front insertions */
+         long              _backSeq, _frontSeq;
+
+         /*! \brief Lowest priority first */
+         bool              _reverse;
+
+         /*! \brief Counts the number of WDs in the queue for each architecture */
+         WDDeviceCounter   _ndevs;
+         bool              _deviceCounter;
+
+         /*! \brief Functor that will be used to get the priority or
+          *  deadline */
+         PriorityValueFun  _getter;
+
+         /*! \brief Max and min priorities found at the queue.
+          *  \note The minimum is a lower bound: it is the lowest priority
+          *  inserted since the queue was empty for the last time.
+          */
+         WD::PriorityType  _maxPriority, _minPriority;
+
+      private:
+         /*! \brief WDHeapPriorityQueue copy constructor (private)
+          */
+         WDHeapPriorityQueue ( const WDHeapPriorityQueue & );
+         /*! \brief WDHeapPriorityQueue copy assignment operator (private)
+          */
+         const WDHeapPriorityQueue & operator= ( const WDHeapPriorityQueue & );
+
+         /*! \brief Whether entry 'a' must be retrieved before entry 'b' */
+         bool before ( const Entry &a, const Entry &b ) const;
+         void siftUp ( size_t pos );
+         void siftDown ( size_t pos );
+
+         /*! \brief Inserts a WD in the heap.
+          *  \param fifo Insert WDs with the same priority after the current ones?
+          */
+         void insertOrdered ( WorkDescriptor *wd, bool fifo = true );
+         /*! \brief Removes the element at position 'pos' */
+         void removeAt ( size_t pos );
+         /*! \brief Returns the position of 'wd' in the heap (or the heap size if not found) */
+         size_t find ( const WorkDescriptor *wd ) const;
+         /*! \brief Updates max and min priorities after an extraction */
+         void updatePriorities ();
+
+         /*! \brief Retrieves the best WD satisfying the constraints
+          *  \note The heap is visited in priority order, without modifying it.
+          */
+         template <typename Constraints>
+         WorkDescriptor * popWithConstraints ( BaseThread *thread );
+
+         void increaseTasksInQueues( int increment = 1 );
+         void decreaseTasksInQueues( int decrement = 1 );
+
+         void increaseDeviceCounter ( WorkDescriptor *wd );
+         void decreaseDeviceCounter ( WorkDescriptor *wd );
+
+      public:
+         /*! \brief WDHeapPriorityQueue default constructor
+          */
+         WDHeapPriorityQueue( bool enableDeviceCounter = true, bool reverse = false,
+               PriorityValueFun getter = std::mem_fun( &WD::getPriority ) );
+
+         /*! \brief WDHeapPriorityQueue destructor
+          */
+         ~WDHeapPriorityQueue() {}
+
+         bool empty ( void ) const;
+         size_t size() const;
+
+         void push_back( WorkDescriptor *wd );
+         void push_front( WorkDescriptor *wd );
+
+         Lock& getLock();
+         void push_front( WD** wds, size_t numElems );
+         void push_back( WD** wds, size_t numElems );
+
+         template <typename Constraints>
+         WorkDescriptor * popFrontWithConstraints ( BaseThread *thread );
+         template <typename Constraints>
+         WorkDescriptor * popBackWithConstraints ( BaseThread *thread );
+         template <typename Constraints>
+         bool removeWDWithConstraints( BaseThread *thread, WorkDescriptor *toRem, WorkDescriptor **next );
+
+         WorkDescriptor * pop_back ( BaseThread *thread );
+         WorkDescriptor * pop_front ( BaseThread *thread );
+
+         bool removeWD( BaseThread *thread, WorkDescriptor *toRem, WorkDescriptor **next );
+
+         /*! \brief Reorders a WD in the current queue.
+          * It is needed when the priority of a WD is changed.
+          * \note The WD is inserted again as if it was pushed back.
+          * \return If the WD was found or not.
+          * \note This method sets the lock upon entry (using LockBlock).
+          */
+         bool reorderWD( WorkDescriptor *wd );
+
+         /*! \brief Returns the highest priority, without blocking.
+          */
+         WD::PriorityType maxPriority() const;
+
+         /*! \brief Returns the lowest priority, without blocking.
+          */
+         WD::PriorityType minPriority() const;
+
+         bool testDequeue();
+   };
+
 
 } // namespace nanos
 
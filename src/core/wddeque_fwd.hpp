@@ -26,7 +26,10 @@ namespace nanos {
    class WDPool;
    class WDDeque;
    class WDLFQueue;
+   class WDWorkStealingDeque;
+   class WDPriorityPool;
    template<typename T> class WDPriorityQueue;
+   template<typename T> class WDHeapPriorityQueue;
 
 } // namespace nanos
 
@@ -403,6 +403,45 @@ void WorkDescriptor::printCopies()
       std::cerr << "############################################"<< std::endl;
 
 }
+
+//! \brief Prefetches the accessed part of dimension 'dim' of a region, and the dimensions below it
+static void prefetchRegion( char *base, nanos_region_dimension_internal_t const *dims, int dim, bool write, size_t &budget )
+{
+   enum { CACHE_LINE_SIZE = 64 };
+
+   if ( dim == 0 ) {
+      size_t len = std::min<size_t>( dims[0].accessed_length, budget );
+      char *start = base + dims[0].lower_bound;
+      char *line = (char *) ( (uintptr_t) start & ~( (uintptr_t) CACHE_LINE_SIZE - 1 ) );
+      // __builtin_prefetch needs constant arguments for the access kind
+      if ( write ) {
+         for ( ; line < start + len; line += CACHE_LINE_SIZE ) __builtin_prefetch( line, 1, 3 );
+      } else {
+         for ( ; line < start + len; line += CACHE_LINE_SIZE ) __builtin_prefetch( line, 0, 3 );
+      }
+      budget -= len;
+      return;
+   }
+
+   size_t stride = dims[0].size;
+   for ( int i = 1; i < dim; i++ ) stride *= dims[i].size;
+
+   for ( size_t i = 0; i < dims[dim].accessed_length && budget > 0; i++ ) {
+      prefetchRegion( base + ( dims[dim].lower_bound + i ) * stride, dims, dim - 1, write, budget );
+   }
+}
+
+void WorkDescriptor::prefetchCopies( size_t budget ) const
+{
+   for ( unsigned int i = 0; i < _numCopies && budget > 0; i++ ) {
+      CopyData const &cd = _copies[i];
+      if ( cd.getNumDimensions() == 0 ) continue;
+
+      prefetchRegion( (char *) cd.getBaseAddress(), cd.getDimensions(), cd.getNumDimensions() - 1,
+            cd.isOutput() && !cd.isInput(), budget );
+   }
+}
+
 void WorkDescriptor::setNotifyCopyFunc( void (*func)(WD &, BaseThread const&) ) {
    _notifyCopy = func;
 }
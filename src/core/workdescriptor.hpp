@@ -33,8 +33,10 @@
 #include "schedule.hpp"
 #include "dependenciesdomain.hpp"
 #include "allocator_decl.hpp"
+#include "slaballocator.hpp"
 #include "system.hpp"
 #include "slicer_decl.hpp"
+#include "taskgraph_decl.hpp"
 
 namespace nanos {
 
@@ -54,17 +56,18 @@ inline WorkDescriptor::WorkDescriptor ( int ndevices, DeviceData **devs, size_t
                                  _versionGroupId( 0 ), _executionTime( 0.0 ), _estimatedExecTime( 0.0 ),
                                  _doSubmit(NULL), _doWait(), _depsDomain( sys.getDependenciesManager()->createDependenciesDomain() ),
                                  _translateArgs( translate_args ),
-                                 _priority( 0 ), _commutativeOwnerMap(NULL), _commutativeOwners(NULL),
+                                 _priority( 0 ), _footprint( 0 ), _commutativeOwnerMap(NULL), _commutativeOwners(NULL),
                                  _copiesNotInChunk(false), _description(description), _instrumentationContextData(), _slicer(NULL),
                                  _taskReductions(),
                                  _notifyCopy( NULL ), _notifyThread( NULL ), _remoteAddr( NULL ), _callback(0), _arguments(0),
-                                 _submittedWDs( NULL ), _reachedTaskwait( false ), _schedPredecessorLocs(),
+                                 _submittedWDs( NULL ), _reachedTaskwait( false ), _capturedGraph( NULL ), _schedPredecessorLocs(),
                                  _mcontrol( this, numCopies )
                                  {
                                     _flags.is_final = 0;
                                     _flags.is_submitted = false;
                                     _flags.is_recoverable = false;
                                     _flags.is_invalid = false;
+                                    _flags.is_slab_chunk = false;
                                     if ( copies != NULL ) {
                                        for ( unsigned int i = 0; i < numCopies; i += 1 ) {
                                           copies[i].setHostBaseAddress( 0 );
@@ -92,10 +95,10 @@ inline WorkDescriptor::WorkDescriptor ( DeviceData *device, size_t data_size, si
                                  _versionGroupId( 0 ), _executionTime( 0.0 ), _estimatedExecTime( 0.0 ),
                                  _doSubmit(NULL), _doWait(), _depsDomain( sys.getDependenciesManager()->createDependenciesDomain() ),
                                  _translateArgs( translate_args ),
-                                 _priority( 0 ),  _commutativeOwnerMap(NULL), _commutativeOwners(NULL),
+                                 _priority( 0 ), _footprint( 0 ),  _commutativeOwnerMap(NULL), _commutativeOwners(NULL),
                                  _copiesNotInChunk(false), _description(description), _instrumentationContextData(), _slicer(NULL), _taskReductions(),
                                  _notifyCopy( NULL ), _notifyThread( NULL ), _remoteAddr( NULL ), _callback(0), _arguments(0),
-                                 _submittedWDs( NULL ), _reachedTaskwait( false ), _schedPredecessorLocs(),
+                                 _submittedWDs( NULL ), _reachedTaskwait( false ), _capturedGraph( NULL ), _schedPredecessorLocs(),
                                  _mcontrol( this, numCopies )
                                  {
                                      _devices = new DeviceData*[1];
@@ -104,6 +107,7 @@ inline WorkDescriptor::WorkDescriptor ( DeviceData *device, size_t data_size, si
                                     _flags.is_submitted = false;
                                     _flags.is_recoverable = false;
                                     _flags.is_invalid = false;
+                                    _flags.is_slab_chunk = false;
                                     if ( copies != NULL ) {
                                        for ( unsigned int i = 0; i < numCopies; i += 1 ) {
                                           copies[i].setHostBaseAddress( 0 );
@@ -131,10 +135,10 @@ inline WorkDescriptor::WorkDescriptor ( const WorkDescriptor &wd, DeviceData **d
                                  _estimatedExecTime( wd._estimatedExecTime ), _doSubmit(NULL), _doWait(),
                                  _depsDomain( sys.getDependenciesManager()->createDependenciesDomain() ),
                                  _translateArgs( wd._translateArgs ),
-                                 _priority( wd._priority ), _commutativeOwnerMap(NULL), _commutativeOwners(NULL),
+                                 _priority( wd._priority ), _footprint( 0 ), _commutativeOwnerMap(NULL), _commutativeOwners(NULL),
                                  _copiesNotInChunk( wd._copiesNotInChunk), _description(description), _instrumentationContextData(), _slicer(wd._slicer), _taskReductions(),
                                  _notifyCopy( NULL ), _notifyThread( NULL ), _remoteAddr( NULL ), _callback(0), _arguments(0),
-                                 _submittedWDs( NULL ), _reachedTaskwait( false ), _schedPredecessorLocs(),
+                                 _submittedWDs( NULL ), _reachedTaskwait( false ), _capturedGraph( NULL ), _schedPredecessorLocs(),
                                  _mcontrol( this, wd._numCopies )
                                  {
                                     if ( wd._parent != NULL ) wd._parent->addWork(*this);
@@ -145,6 +149,7 @@ inline WorkDescriptor::WorkDescriptor ( const WorkDescriptor &wd, DeviceData **d
                                     _flags.is_implicit = wd._flags.is_implicit;
                                     _flags.is_recoverable = wd._flags.is_recoverable;
                                     _flags.is_invalid = false;
+                                    _flags.is_slab_chunk = false;
                                     _flags.is_runtime_task = wd._flags.is_runtime_task;
 
                                     _mcontrol.preInit();
@@ -359,6 +364,10 @@ inline void WorkDescriptor::setEstimatedExecutionTime( double time ) { _estimate
 
 inline DOSubmit * WorkDescriptor::getDOSubmit() { return _doSubmit; }
 
+inline TaskGraph * WorkDescriptor::getCapturedGraph() const { return _capturedGraph; }
+
+inline void WorkDescriptor::setCapturedGraph( TaskGraph *graph ) { _capturedGraph = graph; }
+
 inline int WorkDescriptor::getNumDepsPredecessors() { return ( _doSubmit == NULL ? 0 : _doSubmit->numPredecessors() ); }
 
 inline bool WorkDescriptor::hasDepsPredecessors() { return ( _doSubmit == NULL ? false : ( _doSubmit->numPredecessors() != 0 ) ); }
@@ -368,8 +377,11 @@ inline void WorkDescriptor::submitWithDependencies( WorkDescriptor &wd, size_t n
    wd._doSubmit = NEW DOSubmit();
    wd._doSubmit->setWD(&wd);
 
+   // Captured tasks are recorded before the domain can find any edge to them
+   if ( _capturedGraph != NULL ) _capturedGraph->captureNode( wd, numDeps, deps );
+
    // Defining call back (cb)
-   SchedulePolicySuccessorFunctor cb( *sys.getDefaultSchedulePolicy() );
+   SchedulePolicySuccessorFunctor cb( *sys.getDefaultSchedulePolicy(), _capturedGraph );
 
    initCommutativeAccesses( wd, numDeps, deps );
 
@@ -458,6 +470,9 @@ inline void WorkDescriptor::setPriority( WorkDescriptor::PriorityType priority )
 }
 inline WorkDescriptor::PriorityType WorkDescriptor::getPriority() const { return _priority; }
 
+inline void WorkDescriptor::setFootprint( size_t bytes ) { _footprint = bytes; }
+inline size_t WorkDescriptor::getFootprint() const { return _footprint; }
+
 inline void WorkDescriptor::releaseCommutativeAccesses()
 {
    if ( _commutativeOwners == NULL ) return;
@@ -487,6 +502,21 @@ inline void WorkDescriptor::setRuntimeTask( bool b )
 
 inline bool WorkDescriptor::isRuntimeTask( void ) const { return _flags.is_runtime_task; }
 
+inline void WorkDescriptor::setSlabChunk( bool b )
+{
+  _flags.is_slab_chunk = b;
+}
+
+inline void WorkDescriptor::freeChunk( WorkDescriptor *wd, bool destroy )
+{
+   bool slabChunk = wd->_flags.is_slab_chunk;
+
+   if ( destroy ) wd->~WorkDescriptor();
+
+   if ( slabChunk ) SlabAllocator::deallocate( wd );
+   else delete[] (char *) wd;
+}
+
 inline const char * WorkDescriptor::getDescription ( void ) const  { return _description; }
 
 inline void WorkDescriptor::addWork ( WorkDescriptor &work )
@@ -29,6 +29,7 @@
 #include "basethread_fwd.hpp"
 #include "processingelement_fwd.hpp"
 #include "wddeque_fwd.hpp"
+#include "taskgraph_fwd.hpp"
 
 #include "dependableobjectwd_decl.hpp"
 #include "copydata_decl.hpp"
@@ -199,6 +200,7 @@ typedef std::set<const Device *>  DeviceList;
  */
    class WorkDescriptor
    {
+      friend class TaskGraph;
       public: /* types */
          typedef enum { IsNotAUserLevelThread=false, IsAUserLevelThread=true } ULTFlag;
          typedef std::vector<WorkDescriptor **> WorkDescriptorPtrList;
@@ -215,6 +217,7 @@ typedef std::set<const Device *>  DeviceList;
             bool is_recoverable;   //!< Flags a task as recoverable, that is, it can be re-executed if it finished with errors.
             bool is_invalid;       //!< Flags an invalid workdescriptor. Used in resiliency when a task fails.
             bool is_runtime_task;  //!< Is the WD a task for doing runtime jobs?
+            bool is_slab_chunk;    //!< Has the WD chunk been obtained from the WD slab allocator?
          } WDFlags;
          typedef enum { INIT, START, READY, BLOCKED } State;
          typedef int PriorityType;
@@ -257,6 +260,7 @@ typedef std::set<const Device *>  DeviceList;
          DependenciesDomain           *_depsDomain;             //!< Dependences domain. Each WD has one where DependableObjects can be submitted            //!< Directory to mantain cache coherence
          nanos_translate_args_t        _translateArgs;          //!< Translates the addresses in _data to the ones obtained by get_address()
          PriorityType                  _priority;               //!< Task priority
+         size_t                        _footprint;              //!< Bytes of data accesses accounted to this WD by the throttle policy
          CommutativeOwnerMap          *_commutativeOwnerMap;    //!< Map from commutative target address to owner pointer
          WorkDescriptorPtrList        *_commutativeOwners;      //!< Array of commutative target owners
          int                           _numaNode;               //!< FIXME:scheduler data. The NUMA node this WD was assigned to
@@ -275,6 +279,7 @@ typedef std::set<const Device *>  DeviceList;
          void                         *_arguments;
          std::vector<WorkDescriptor *>*_submittedWDs;
          bool                          _reachedTaskwait;
+         TaskGraph                    *_capturedGraph;          //!< Graph recording the tasks submitted by this WD (NULL if not capturing)
       public:
          int                           _schedValues[8];
          std::map<memory_space_id_t,unsigned int>   _schedPredecessorLocs;
@@ -535,6 +540,11 @@ typedef std::set<const Device *>  DeviceList;
           */
          size_t getCopiesSize() const;
 
+         /*! \brief issues software prefetches for the data accessed through the copies of the WD
+          *  \param budget maximum number of bytes to prefetch
+          */
+         void prefetchCopies( size_t budget ) const;
+
          /*! \brief perform (submit) all output copies
           */
          void submitOutputCopies ();
@@ -638,6 +648,12 @@ typedef std::set<const Device *>  DeviceList;
 
          void setPriority( PriorityType priority );
          PriorityType getPriority() const;
+
+         /*! \brief Sets the bytes of data accesses accounted to this WD by the throttle policy
+          */
+         void setFootprint( size_t bytes );
+         size_t getFootprint() const;
+
          void setNotifyCopyFunc( void (*func)(WD &, BaseThread const &) );
 
          void notifyCopy();
@@ -661,6 +677,18 @@ typedef std::set<const Device *>  DeviceList;
          void setRuntimeTask( bool b = true );
          bool isRuntimeTask( void ) const;
 
+         /*! \brief Marks the WD chunk as allocated by the WD slab allocator (see System::createWD)
+          */
+         void setSlabChunk( bool b = true );
+
+         /*! \brief Releases the memory chunk holding 'wd', calling its destructor if 'destroy' is set
+          *
+          *  WDs created by System::createWD or System::duplicateWD live in a
+          *  chunk coming from the slab allocator, while the rest of them have
+          *  been allocated as a plain char array.
+          */
+         static void freeChunk( WorkDescriptor *wd, bool destroy = true );
+
          /*! \brief Set copies for a given WD
           * We call this when copies cannot be set at creation time of the work descriptor
           * Note that this should only be done between creation and submit.
@@ -745,6 +773,11 @@ typedef std::set<const Device *>  DeviceList;
          //         the commutative access map that the caller provides.
          int getConcurrencyLevel( std::map<WD**, WD*> &comm_accesses ) const;
          void addPresubmittedWDs( unsigned int numWDs, WD **wds );
+
+         //! \brief Returns the graph capturing the tasks submitted by this WD (NULL if none)
+         TaskGraph * getCapturedGraph ( void ) const;
+         //! \brief Starts (graph != NULL) or stops (graph == NULL) capturing the tasks submitted by this WD
+         void setCapturedGraph ( TaskGraph *graph );
    };
 
    typedef class WorkDescriptor WD;
@@ -0,0 +1,306 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "barrier.hpp"
+#include "system.hpp"
+#include "atomic.hpp"
+#include "schedule.hpp"
+#include "plugin.hpp"
+#include "synchronizedcondition.hpp"
+#include <map>
+#include <vector>
+
+namespace nanos {
+   namespace ext {
+
+      /*! \class HierarchicalBarrier
+       *  \brief implements a combining tree barrier shaped after the machine topology
+       *
+       *  Participants are grouped by the NUMA node of the CPU they run on. Inside each group the
+       *  participants sharing a cache are placed next to each other in a 4-ary tree rooted at the
+       *  group leader, and the group leaders form another 4-ary tree rooted at participant 0.
+       *  Every participant only spins on flags stored in its own node, and flags are compared
+       *  against a sense value that flips on each barrier so they never have to be reset.
+       *
+       *  The tree is rebuilt when the team is resized, and also at the end of a barrier when some
+       *  participant has moved to another CPU since the tree was built (e.g. when DLB lends or
+       *  reclaims CPUs). Without hwloc all participants fall in the same group.
+       */
+      class HierarchicalBarrier: public Barrier
+      {
+
+         private:
+            enum { ARITY = 4, MAX_CHILDREN = 2 * ARITY, CACHE_LINE_SIZE = 64 };
+
+            typedef SingleSyncCond<EqualConditionChecker<int> > FlagCondition;
+
+            /*! Per participant data. Only the owner waits on the flags, its children write the
+             *  arrival flags and its parent writes the release flag.
+             */
+            typedef struct {
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+               int             arrived[MAX_CHILDREN];
+               int             release;
+#else
+               volatile int    arrived[MAX_CHILDREN];
+               volatile int    release;
+#endif
+               FlagCondition   arrivedCondition[MAX_CHILDREN];
+               FlagCondition   releaseCondition;
+               int             sense;                  /**< value that flags take in the current barrier */
+               int             cpu;                    /**< CPU the participant was running on in its last arrival */
+               int             treeCpu;                /**< CPU the participant was assumed to run on when the tree was built */
+               int             parent;
+               int             slot;                   /**< position of this node among its parent's children */
+               int             numChildren;
+               int             children[MAX_CHILDREN];
+               char            pad[CACHE_LINE_SIZE];   /**< keeps the next node out of our last cache line */
+            } Node;
+
+            typedef std::vector<Node *> Nodes;
+
+            Nodes             _nodes;
+            int               _numParticipants;
+            bool              _topologyAware;
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+            bool              _moved;
+#else
+            volatile bool     _moved;
+#endif
+
+            void link ( int parent, int child );
+            void orderGroup ( std::vector<int> &members );
+            void buildTree ( int sense );
+
+         public:
+            HierarchicalBarrier () : Barrier(), _nodes(), _numParticipants( 0 ),
+               _topologyAware( sys._hwloc.isHwlocAvailable() ), _moved( false ) {}
+            HierarchicalBarrier ( const HierarchicalBarrier& orig ) : Barrier(orig), _nodes(), _numParticipants( 0 ),
+               _topologyAware( orig._topologyAware ), _moved( false )
+               { init( orig._numParticipants ); }
+
+            const HierarchicalBarrier & operator= ( const HierarchicalBarrier & orig );
+
+            virtual ~HierarchicalBarrier();
+
+            void init ( int numParticipants );
+            void resize ( int numThreads );
+
+            void barrier ( int participant );
+      };
+
+      const HierarchicalBarrier & HierarchicalBarrier::operator= ( const HierarchicalBarrier & orig )
+      {
+         // self-assignment
+         if ( &orig == this ) return *this;
+
+         Barrier::operator=(orig);
+
+         if ( orig._numParticipants != _numParticipants )
+            resize(orig._numParticipants);
+
+         return *this;
+      }
+
+      HierarchicalBarrier::~HierarchicalBarrier()
+      {
+         for ( Nodes::iterator it = _nodes.begin(); it != _nodes.end(); it++ ) delete *it;
+      }
+
+      void HierarchicalBarrier::init( int numParticipants )
+      {
+         resize( numParticipants );
+      }
+
+      void HierarchicalBarrier::resize( int numParticipants )
+      {
+         for ( int i = numParticipants; i < (int) _nodes.size(); i++ ) delete _nodes[i];
+         _nodes.resize( numParticipants, NULL );
+         _numParticipants = numParticipants;
+
+         //setting the flags to the initial value
+         for ( int i = 0; i < _numParticipants; i++ ) {
+            if ( _nodes[i] == NULL ) {
+               _nodes[i] = NEW Node();
+               _nodes[i]->cpu = -1;
+            }
+            _nodes[i]->release = 0;
+            _nodes[i]->sense = 1;
+         }
+
+         buildTree( 0 );
+      }
+
+      /*! \brief Appends child to the children of parent
+       */
+      void HierarchicalBarrier::link( int parent, int child )
+      {
+         Node &p = *_nodes[parent];
+         ensure( p.numChildren < MAX_CHILDREN, "Too many children in hierarchical barrier node" );
+
+         _nodes[child]->parent = parent;
+         _nodes[child]->slot = p.numChildren;
+         p.children[p.numChildren++] = child;
+      }
+
+      /*! \brief Orders the members of a group so that participants sharing a cache are contiguous
+       *
+       *  The first member (the group leader) keeps its position.
+       */
+      void HierarchicalBarrier::orderGroup( std::vector<int> &members )
+      {
+         std::vector<int> ordered;
+         std::vector<bool> placed( members.size(), false );
+
+         for ( unsigned i = 0; i < members.size(); i++ ) {
+            if ( placed[i] ) continue;
+            ordered.push_back( members[i] );
+            placed[i] = true;
+
+            int cpu = _nodes[members[i]]->cpu;
+            if ( cpu < 0 ) continue;
+
+            for ( unsigned j = i + 1; j < members.size(); j++ ) {
+               int other = _nodes[members[j]]->cpu;
+               if ( !placed[j] && other >= 0 && sys._hwloc.getCpuDistance( cpu, other ) <= 1 ) {
+                  ordered.push_back( members[j] );
+                  placed[j] = true;
+               }
+            }
+         }
+
+         members.swap( ordered );
+      }
+
+      /*! \brief Computes the tree shape from the last known CPU of each participant
+       *
+       *  \param sense arrival flags are left holding this value, so that they do not look set
+       *         for the next barrier
+       *  \warning Must be called while no other participant is arriving to the barrier
+       */
+      void HierarchicalBarrier::buildTree( int sense )
+      {
+         typedef std::map<unsigned, std::vector<int> > Groups;
+         Groups groups;
+
+         for ( int i = 0; i < _numParticipants; i++ ) {
+            Node &node = *_nodes[i];
+            unsigned numa = 0;
+            if ( _topologyAware && node.cpu >= 0 ) numa = sys._hwloc.getNumaNodeOfCpu( node.cpu );
+
+            groups[numa].push_back( i );
+
+            node.treeCpu = node.cpu;
+            node.parent = -1;
+            node.slot = 0;
+            node.numChildren = 0;
+            for ( int c = 0; c < MAX_CHILDREN; c++ ) node.arrived[c] = sense;
+         }
+
+         // Participants are added in increasing order, so each group starts with its leader
+         std::vector<int> leaders;
+         for ( Groups::iterator it = groups.begin(); it != groups.end(); it++ ) {
+            std::vector<int> &members = it->second;
+            orderGroup( members );
+            for ( unsigned p = 1; p < members.size(); p++ ) link( members[(p - 1) / ARITY], members[p] );
+
+            if ( members[0] == 0 ) leaders.insert( leaders.begin(), 0 );
+            else leaders.push_back( members[0] );
+         }
+
+         for ( unsigned p = 1; p < leaders.size(); p++ ) link( leaders[(p - 1) / ARITY], leaders[p] );
+
+         _moved = false;
+         memoryFence();
+      }
+
+      void HierarchicalBarrier::barrier( int participant )
+      {
+         Node &me = *_nodes[participant];
+         int sense = me.sense;
+
+         if ( _topologyAware ) {
+            me.cpu = myThread->getCpuId();
+            if ( me.cpu != me.treeCpu ) _moved = true;
+         }
+
+         /*! Gather phase: wait for each child and fold its private reduction copies into ours,
+          *  so the root only has to combine its own copy with the original data.
+          */
+         for ( int c = 0; c < me.numChildren; c++ ) {
+            me.arrivedCondition[c].setConditionChecker( EqualConditionChecker<int>( &me.arrived[c], sense ) );
+            me.arrivedCondition[c].wait();
+            combineVectorReductions( participant, me.children[c] );
+         }
+
+         if ( participant != 0 ) {
+            me.releaseCondition.setConditionChecker( EqualConditionChecker<int>( &me.release, sense ) );
+            memoryFence();
+
+            Node &parent = *_nodes[me.parent];
+            parent.arrived[me.slot] = sense;
+            parent.arrivedCondition[me.slot].signal();
+
+            /*! Release phase: wait for our parent */
+            me.releaseCondition.wait();
+         } else {
+            finishVectorReductions();
+
+            // Everybody is waiting to be released: it is safe to reshape the tree
+            if ( _moved ) buildTree( sense );
+         }
+
+         memoryFence();
+
+         for ( int c = 0; c < me.numChildren; c++ ) {
+            Node &child = *_nodes[me.children[c]];
+            child.release = sense;
+            child.releaseCondition.signal();
+         }
+
+         me.sense = 1 - sense;
+      }
+
+
+      static Barrier * createHierarchicalBarrier()
+      {
+         return NEW HierarchicalBarrier();
+      }
+
+
+      /*! \class HierarchicalBarrierPlugin
+       *  \brief plugin of the related HierarchicalBarrier class
+       *  \see HierarchicalBarrier
+       */
+      class HierarchicalBarrierPlugin : public Plugin
+      {
+
+         public:
+            HierarchicalBarrierPlugin() : Plugin( "Hierarchical Barrier Plugin",1 ) {}
+
+            virtual void config( Config &cfg ) {}
+
+            virtual void init() {
+               sys.setDefaultBarrFactory( createHierarchicalBarrier );
+            }
+      };
+   }
+}
+
+DECLARE_PLUGIN("barr-hierarchical",nanos::ext::HierarchicalBarrierPlugin);
@@ -139,15 +139,24 @@ namespace nanos {
           memoryFence();
 
 
-         /*! Bottom-Up phase: check if I am leaf and possibly wait for children */
-         if ( left_child < _numParticipants )
+         /*! Bottom-Up phase: check if I am leaf and possibly wait for children.
+          *  The private copies of the team reductions are folded along the way, so the
+          *  root only has to combine its own copy with the original data.
+          */
+         if ( left_child < _numParticipants ) {
             _sems[myID].leftCondition.wait();
+            combineVectorReductions( myID, left_child );
+         }
 
-         if ( right_child < _numParticipants )
+         if ( right_child < _numParticipants ) {
             _sems[myID].rightCondition.wait();
+            combineVectorReductions( myID, right_child );
+         }
 
          /*! the bottom-up phase terminates with the root node (id = 0) */
          if ( myID != 0 ) {
+            memoryFence();
+
             /*! now I can signal my parent: I first need to know if I am left or right child */
             if ( 2*parent + 1 == myID ) {
                _sems[parent].left = currPhase;
@@ -163,6 +172,8 @@ namespace nanos {
             /*! Top-Down phase: wait for the signal from the parent */
             _sems[myID].parentCondition.wait();
 
+         } else {
+            finishVectorReductions();
          }
 
          /*! signaling the children if there are */
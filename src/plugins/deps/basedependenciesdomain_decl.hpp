@@ -35,7 +35,7 @@ namespace nanos {
    class BaseDependenciesDomain : public DependenciesDomain
    {
       protected:
-         unsigned int _lastDepObjId;         /**< Id to be given to the next submitted DependableObject */
+         Atomic<unsigned int> _lastDepObjId; /**< Id to be given to the next submitted DependableObject */
       private:
          /*! \brief Creates a CommutationDO and attaches it to the trackable object.
           *  \param target accessed base address/region
@@ -24,6 +24,8 @@
 #include "address.hpp"
 #include "compatibility.hpp"
 
+#define NANOS_PLAIN_DEPS_SHARDS 16 /* Must be a power of two */
+
 namespace nanos {
    namespace ext {
 
@@ -31,18 +33,53 @@ namespace nanos {
       {
          private:
             typedef TR1::unordered_map<Address::TargetType, TrackableObject*> DepsMap; /**< Maps addresses to Trackable objects */
+
+            //! \brief Slice of the address map protected by its own lock
+            struct DepsMapShard {
+               Lock     _lock;                    /**< Protects _map */
+               DepsMap  _map;                     /**< Addresses falling in this shard */
+               char     _pad[NANOS_CACHELINE];    /**< Keeps shard locks in different cache lines */
+            };
             
          private:
-            DepsMap _addressDependencyMap; /**< Used to track dependencies between DependableObject */
+            //! \brief Used to track dependencies between DependableObject
+            //!
+            //! Addresses are spread among NANOS_PLAIN_DEPS_SHARDS maps, so tasks created (or
+            //! finished) by different threads do not serialize on a domain wide lock. As every
+            //! WD owns a domain, shards are only allocated when the first dependence is found.
+            DepsMapShard * volatile _shards;
          private:
 
+            //! \brief Returns the shard holding the given address
+            DepsMapShard & getShard ( Address::TargetType target ) const
+            {
+               uintptr_t key = (uintptr_t) target;
+               // Dependences are usually aligned, discard the lower bits
+               key = ( key >> 6 ) ^ ( key >> 12 );
+               return _shards[ key & ( NANOS_PLAIN_DEPS_SHARDS - 1 ) ];
+            }
+
+            //! \brief Allocates the shards, if it is not done yet
+            void createShards ( void )
+            {
+               SyncRecursiveLockBlock lock1( getInstanceLock() );
+               if ( _shards == NULL ) {
+                  DepsMapShard *shards = NEW DepsMapShard[NANOS_PLAIN_DEPS_SHARDS];
+                  memoryFence();
+                  _shards = shards;
+               }
+            }
+
             //! \brief Clear current dependencies domain
             //!
             //! This function should be called withing a thread safe area. It is, when other
             //! tasks can not update the domain: after a taskwait and before any task submission.
             void clearDependenciesDomain ( void )
             {
-               _addressDependencyMap.clear(); 
+               if ( _shards == NULL ) return;
+               for ( unsigned int i = 0; i < NANOS_PLAIN_DEPS_SHARDS; i++ ) {
+                  _shards[i]._map.clear();
+               }
             }
 
             //! \brief Looks for the dependency's address, returns the trackableObject associated
@@ -51,17 +88,19 @@ namespace nanos {
             TrackableObject* lookupDependency ( const Address& target )
             {
                TrackableObject* status = NULL;
-               
-               DepsMap::iterator it = _addressDependencyMap.find( target() ); 
 
-               if ( it == _addressDependencyMap.end() ) {
+               if ( _shards == NULL ) createShards();
+
+               // Lock the shard so we avoid problems when concurrently calling deleteLastWriter
+               // (or other creators), as they will also chase the map
+               DepsMapShard &shard = getShard( target() );
+               SyncLockBlock lock1( shard._lock );
+
+               DepsMap::iterator it = shard._map.find( target() ); 
+
+               if ( it == shard._map.end() ) {
                    status = NEW TrackableObject();
-                   {
-                      // Lock this so we avoid problems when concurrently calling deleteLastWriter
-                      // due this function will also chase also the map
-                      SyncRecursiveLockBlock lock1( getInstanceLock() );
-                      _addressDependencyMap.insert( std::make_pair( target(), status ) );
-                   }
+                   shard._map.insert( std::make_pair( target(), status ) );
                } else {
                   status = it->second;
                }
@@ -157,10 +196,12 @@ namespace nanos {
             inline void deleteLastWriter ( DependableObject &depObj, BaseDependency const &target )
             {
                const Address& address( static_cast<const Address&>( target ) );
-               SyncRecursiveLockBlock lock1( getInstanceLock() );
-               DepsMap::iterator it = _addressDependencyMap.find( address() );
+               if ( _shards == NULL ) return;
+               DepsMapShard &shard = getShard( address() );
+               SyncLockBlock lock1( shard._lock );
+               DepsMap::iterator it = shard._map.find( address() );
                
-               if ( it != _addressDependencyMap.end() ) {
+               if ( it != shard._map.end() ) {
                   TrackableObject &status = *it->second;
                   
                   status.deleteLastWriter(depObj);
@@ -171,10 +212,12 @@ namespace nanos {
             inline void deleteReader ( DependableObject &depObj, BaseDependency const &target )
             {
                const Address& address( static_cast<const Address&>( target ) );
-               SyncRecursiveLockBlock lock1( getInstanceLock() );
-               DepsMap::iterator it = _addressDependencyMap.find( address() );
+               if ( _shards == NULL ) return;
+               DepsMapShard &shard = getShard( address() );
+               SyncLockBlock lock1( shard._lock );
+               DepsMap::iterator it = shard._map.find( address() );
                
-               if ( it != _addressDependencyMap.end() ) {
+               if ( it != shard._map.end() ) {
                   TrackableObject &status = *it->second;
                   
                   {
@@ -187,10 +230,12 @@ namespace nanos {
             inline void removeCommDO ( CommutationDO *commDO, BaseDependency const &target )
             {
                const Address& address( static_cast<const Address&>( target ) );
-               SyncRecursiveLockBlock lock1( getInstanceLock() );
-               DepsMap::iterator it = _addressDependencyMap.find( address() );
+               if ( _shards == NULL ) return;
+               DepsMapShard &shard = getShard( address() );
+               SyncLockBlock lock1( shard._lock );
+               DepsMap::iterator it = shard._map.find( address() );
                
-               if ( it != _addressDependencyMap.end() ) {
+               if ( it != shard._map.end() ) {
                   TrackableObject &status = *it->second;
                   
                   if ( status.getCommDO ( ) == commDO ) {
@@ -200,16 +245,27 @@ namespace nanos {
             }
 
          public:
-            PlainDependenciesDomain() : BaseDependenciesDomain(), _addressDependencyMap() {}
+            PlainDependenciesDomain() : BaseDependenciesDomain(), _shards( NULL ) {}
             PlainDependenciesDomain ( const PlainDependenciesDomain &depDomain )
-               : BaseDependenciesDomain( depDomain ),
-               _addressDependencyMap ( depDomain._addressDependencyMap ) {}
+               : BaseDependenciesDomain( depDomain ), _shards( NULL )
+            {
+               if ( depDomain._shards != NULL ) {
+                  createShards();
+                  for ( unsigned int i = 0; i < NANOS_PLAIN_DEPS_SHARDS; i++ ) {
+                     _shards[i]._map = depDomain._shards[i]._map;
+                  }
+               }
+            }
             
             ~PlainDependenciesDomain()
             {
-               for ( DepsMap::iterator it = _addressDependencyMap.begin(); it != _addressDependencyMap.end(); it++ ) {
-                  delete it->second;
+               if ( _shards == NULL ) return;
+               for ( unsigned int i = 0; i < NANOS_PLAIN_DEPS_SHARDS; i++ ) {
+                  for ( DepsMap::iterator it = _shards[i]._map.begin(); it != _shards[i]._map.end(); it++ ) {
+                     delete it->second;
+                  }
                }
+               delete[] _shards;
             }
             
             /*!
@@ -234,8 +290,11 @@ namespace nanos {
 
             bool haveDependencePendantWrites ( void *addr )
             {
-               DepsMap::iterator it = _addressDependencyMap.find( addr ); 
-               if ( it == _addressDependencyMap.end() ) {
+               if ( _shards == NULL ) return false;
+               DepsMapShard &shard = getShard( addr );
+               SyncLockBlock lock1( shard._lock );
+               DepsMap::iterator it = shard._map.find( addr ); 
+               if ( it == shard._map.end() ) {
                   return false;
                } else {
                   TrackableObject* status = it->second;
@@ -243,28 +302,34 @@ namespace nanos {
                   return (lastWriter != NULL);
                }
             }
+            //! \note As clearDependenciesDomain, it is called within a thread safe area, shards
+            //! are not locked as releasing the reductions may end up calling removeCommDO.
             void finalizeAllReductions ( void )
             {
-               DepsMap::iterator it; 
-               for ( it = _addressDependencyMap.begin(); it != _addressDependencyMap.end(); it++ ) {
-                  TrackableObject& status = *( it->second );
-                  Address::TargetType target = it->first;
-                  CommutationDO *commDO = status.getCommDO();
-                  if ( commDO != NULL ) {
-                     status.setCommDO( NULL );
-                     status.setLastWriter( *commDO );
+               if ( _shards == NULL ) return;
+               for ( unsigned int i = 0; i < NANOS_PLAIN_DEPS_SHARDS; i++ ) {
+                  DepsMap &map = _shards[i]._map;
+                  DepsMap::iterator it; 
+                  for ( it = map.begin(); it != map.end(); it++ ) {
+                     TrackableObject& status = *( it->second );
+                     Address::TargetType target = it->first;
+                     CommutationDO *commDO = status.getCommDO();
+                     if ( commDO != NULL ) {
+                        status.setCommDO( NULL );
+                        status.setLastWriter( *commDO );
 
-                     TaskReduction *tr = myThread->getCurrentWD()->getTaskReduction( (const void *) target );
-                     if ( tr != NULL ) {
-                        if ( myThread->getCurrentWD()->getDepth() == tr->getDepth() )
-							commDO->setTaskReduction( tr );
-                     }
+                        TaskReduction *tr = myThread->getCurrentWD()->getTaskReduction( (const void *) target );
+                        if ( tr != NULL ) {
+                           if ( myThread->getCurrentWD()->getDepth() == tr->getDepth() )
+                              commDO->setTaskReduction( tr );
+                        }
 
-                     commDO->resetReferences();
+                        commDO->resetReferences();
 
-                     //! Finally decrease dummy dependence added in createCommutationDO
-                     std::list<uint64_t> flushDeps;
-                     commDO->decreasePredecessors( &flushDeps, NULL, false, false ); 
+                        //! Finally decrease dummy dependence added in createCommutationDO
+                        std::list<uint64_t> flushDeps;
+                        commDO->decreasePredecessors( &flushDeps, NULL, false, false ); 
+                     }
                   }
                }
             }
@@ -35,7 +35,9 @@ namespace nanos {
 
               TeamData () : ScheduleTeamData(), _readyQueue( NULL )
               {
-                if ( _usePriority || _useSmartPriority ) _readyQueue = NEW WDPriorityQueue<>( true /* enableDeviceCounter */, true /* optimise option */ );
+                if ( ( _usePriority || _useSmartPriority ) && _usePriorityHeap ) _readyQueue = NEW WDHeapPriorityQueue<>( true /* enableDeviceCounter */ );
+                else if ( _usePriority || _useSmartPriority ) _readyQueue = NEW WDPriorityQueue<>( true /* enableDeviceCounter */, true /* optimise option */ );
+                else if ( _useWSDeque ) _readyQueue = NEW WDWorkStealingDeque();
                 else _readyQueue = NEW WDDeque( true /* enableDeviceCounter */ );
               }
               ~TeamData () { delete _readyQueue; }
@@ -45,6 +47,8 @@ namespace nanos {
            static bool       _useStack;
            static bool       _usePriority;
            static bool       _useSmartPriority;
+           static bool       _usePriorityHeap;
+           static bool       _useWSDeque;
 
            BreadthFirst() : SchedulePolicy("Breadth First")
            {
@@ -59,6 +63,9 @@ namespace nanos {
 
          private:
 
+           /*! \brief Returns if the ready queue is a WDWorkStealingDeque (priorities take precedence) */
+           static bool useWSDeque () { return _useWSDeque && !_usePriority && !_useSmartPriority; }
+
            virtual size_t getTeamDataSize () const { return sizeof(TeamData); }
            virtual size_t getThreadDataSize () const { return 0; }
 
@@ -78,7 +85,7 @@ namespace nanos {
               if ( targetThread ) targetThread->addNextWD(&wd);
               else {
                  TeamData &tdata = (TeamData &) *thread->getTeam()->getScheduleData();
-                 if ( _useStack ) return tdata._readyQueue->push_front( &wd );
+                 if ( _useStack || useWSDeque() ) return tdata._readyQueue->push_front( &wd );
                  else tdata._readyQueue->push_back( &wd );
               }
            }
@@ -100,7 +107,7 @@ namespace nanos {
 
                // If they have the same team, we can insert in batch
                TeamData &tdata = (TeamData &) *team->getScheduleData();
-               if ( _useStack ) tdata._readyQueue->push_front( wds, numElems );
+               if ( _useStack || useWSDeque() ) tdata._readyQueue->push_front( wds, numElems );
                else tdata._readyQueue->push_back( wds, numElems );
 
                // Unblock all participant threads
@@ -157,7 +164,7 @@ namespace nanos {
 
                   // Reorder
                   TeamData &tdata = (TeamData &) *myThread->getTeam()->getScheduleData();
-                  WDPriorityQueue<> *q = (WDPriorityQueue<> *) tdata._readyQueue;
+                  WDPriorityPool *q = (WDPriorityPool *) tdata._readyQueue;
                   q->reorderWD( pred );
                }
             }
@@ -173,7 +180,9 @@ namespace nanos {
               WD * next = thread->getNextWD();
               if (!next) {
                  TeamData &tdata = (TeamData &) *thread->getTeam()->getScheduleData();
-                 next = tdata._readyQueue->pop_front( thread );
+                 // The work-stealing deque only inserts at the front, FIFO order is kept popping from the back
+                 if ( useWSDeque() && !_useStack ) next = tdata._readyQueue->pop_back( thread );
+                 else next = tdata._readyQueue->pop_front( thread );
               }
               return next;
            }
@@ -182,7 +191,7 @@ namespace nanos {
            {
               WD * found = current.getImmediateSuccessor(*thread);
               if ( found && (_usePriority || _useSmartPriority) ) {
-                 WDPriorityQueue<> &tdata = (WDPriorityQueue<> &) *((TeamData *) thread->getTeam()->getScheduleData())->_readyQueue;
+                 WDPriorityPool &tdata = (WDPriorityPool &) *((TeamData *) thread->getTeam()->getScheduleData())->_readyQueue;
                  if (found->getPriority() < tdata.maxPriority() ) {
                     queue(thread, *found);
                     found = NULL;
@@ -195,7 +204,7 @@ namespace nanos {
            {
               WD * found = schedule ? current.getImmediateSuccessor(*thread) : NULL;
               if ( found && (_usePriority || _useSmartPriority) ) {
-                 WDPriorityQueue<> &tdata = (WDPriorityQueue<> &) *((TeamData *) thread->getTeam()->getScheduleData())->_readyQueue;
+                 WDPriorityPool &tdata = (WDPriorityPool &) *((TeamData *) thread->getTeam()->getScheduleData())->_readyQueue;
                  if (found->getPriority() < tdata.maxPriority() ) {
                     queue(thread, *found);
                     found = NULL;
@@ -208,7 +217,7 @@ namespace nanos {
             {
               //! \bug FIXME flags of priority must be in queue
                if ( _usePriority || _useSmartPriority ) {
-                  WDPriorityQueue<> *q = (WDPriorityQueue<> *) wd->getMyQueue();
+                  WDPriorityPool *q = (WDPriorityPool *) wd->getMyQueue();
                   return q? q->reorderWD( wd ) : true;
                } else {
                   return true;
@@ -230,6 +239,8 @@ namespace nanos {
       bool BreadthFirst::_useStack = false;
       bool BreadthFirst::_usePriority = true;
       bool BreadthFirst::_useSmartPriority = false;
+      bool BreadthFirst::_usePriorityHeap = false;
+      bool BreadthFirst::_useWSDeque = false;
 
       class BFSchedPlugin : public Plugin
       {
@@ -252,6 +263,12 @@ namespace nanos {
                cfg.registerConfigOption ( "schedule-smart-priority", NEW Config::FlagOption( BreadthFirst::_useSmartPriority ), "Smart priority queue propagates high priorities to predecessors");
                cfg.registerArgOption( "schedule-smart-priority", "schedule-smart-priority" );
 
+               cfg.registerConfigOption ( "schedule-priority-heap", NEW Config::FlagOption( BreadthFirst::_usePriorityHeap ), "Priority queue is kept in a binary heap (logarithmic insertion) instead of an ordered list");
+               cfg.registerArgOption( "schedule-priority-heap", "schedule-priority-heap" );
+
+               cfg.registerConfigOption ( "schedule-ws-deque", NEW Config::FlagOption( BreadthFirst::_useWSDeque ), "Lock-free work-stealing deque used as ready task queue (ignored if priorities are enabled)");
+               cfg.registerArgOption( "schedule-ws-deque", "schedule-ws-deque" );
+
             }
 
             virtual void init() {
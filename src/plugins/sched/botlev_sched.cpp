@@ -115,7 +115,7 @@ namespace nanos {
          public:
             using SchedulePolicy::queue;
             typedef std::stack<BotLevDOData *>   bot_lev_dos_t;
-            typedef std::set<std::pair< unsigned int, DependableObject * > > DepObjVector; /**< Type vector of successors  */
+            typedef SuccessorList DepObjVector; /**< Type vector of successors  */
 
          private:
             bot_lev_dos_t     _blStack;       //! tasks added, pending having their bottom level updated
@@ -246,7 +246,7 @@ namespace nanos {
                    qId = 1;
                    NANOS_INSTRUMENT ( criticality = 1; )
                 }
-                else if( ((_topSuccesors.find( std::make_pair( wd.getId(), dos ) )) != (_topSuccesors.end()))
+                else if( ((_topSuccesors.find( dos )) != (_topSuccesors.end()))
                          && wd.getPriority() >= _currMax-1 ) {
                    //The task is critical
                    {
@@ -355,12 +355,12 @@ namespace nanos {
                BotLevDOData *dodata = new BotLevDOData(++BotLevCfg::taskNumber, 0);
                depObj.setSchedulerData( (DOSchedulerData*) dodata );
 
-               DepObjVector predecessors;
+               DependableObject::DependableObjectVector predecessors;
                { 
                   LockBlock l(depObj.getLock());
                   predecessors = depObj.getPredecessors();
                }
-               for ( DepObjVector::iterator it = predecessors.begin(); it != predecessors.end(); it++ ) {
+               for ( DependableObject::DependableObjectVector::iterator it = predecessors.begin(); it != predecessors.end(); it++ ) {
                   DependableObject *pred = it->second;
                   if (pred) {
                      BotLevDOData *predObj = (BotLevDOData *)pred->getSchedulerData();
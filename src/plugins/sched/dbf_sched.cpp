@@ -31,6 +31,8 @@ namespace nanos {
             using SchedulePolicy::queue;
             static bool       _usePriority;
             static bool       _useSmartPriority;
+            static bool       _usePriorityHeap;
+            static bool       _useWSDeque;
          private:
             /** \brief DistributedBF Scheduler data associated to each thread
               *
@@ -42,7 +44,9 @@ namespace nanos {
 
                ThreadData () : ScheduleThreadData(), _readyQueue( NULL )
                {
-                 if ( _usePriority || _useSmartPriority ) _readyQueue = NEW WDPriorityQueue<>( true /* enableDeviceCounter */, true /* optimise option */ );
+                 if ( ( _usePriority || _useSmartPriority ) && _usePriorityHeap ) _readyQueue = NEW WDHeapPriorityQueue<>( true /* enableDeviceCounter */ );
+                 else if ( _usePriority || _useSmartPriority ) _readyQueue = NEW WDPriorityQueue<>( true /* enableDeviceCounter */, true /* optimise option */ );
+                 else if ( _useWSDeque ) _readyQueue = NEW WDWorkStealingDeque();
                  else _readyQueue = NEW WDDeque( true /* enableDeviceCounter */ );
                }
                virtual ~ThreadData () { delete _readyQueue; }
@@ -115,7 +119,7 @@ namespace nanos {
 
                   // Reorder
                   ThreadData &tdata = (ThreadData &) *myThread->getTeam()->getScheduleData();
-                  WDPriorityQueue<> *q = (WDPriorityQueue<> *) tdata._readyQueue;
+                  WDPriorityPool *q = (WDPriorityPool *) tdata._readyQueue;
                   q->reorderWD( pred );
                }
             }
@@ -137,6 +141,36 @@ namespace nanos {
                }
             }
 
+            /*!
+            *  \brief Enqueue a batch of work descriptors
+            *
+            *  Consecutive WDs targeting the same thread are pushed into its
+            *  readyQueue at once, so the queue lock and the ready task counters
+            *  are taken once per run instead of once per WD.
+            *  \sa isValidForBatch
+            */
+            virtual void queue ( BaseThread ** threads, WD ** wds, size_t numElems )
+            {
+               size_t first = 0;
+               while ( first < numElems ) {
+                  BaseThread *thread = threads[first];
+                  size_t last = first + 1;
+                  while ( last < numElems && threads[last] == thread ) last++;
+
+                  ThreadData &data = ( ThreadData & ) *thread->getTeamData()->getScheduleData();
+                  data._readyQueue->push_front( &wds[first], last - first );
+                  sys.getThreadManager()->unblockThread(thread);
+
+                  first = last;
+               }
+            }
+
+            /*! Tied WDs go to their thread's next WD instead of a readyQueue */
+            bool isValidForBatch ( const WD * wd ) const
+            {
+               return wd->isTiedTo() == NULL;
+            }
+
             /*!
             *  \brief Function called when a new task must be created: the new created task
             *          is directly queued (Breadth-First policy)
@@ -158,7 +192,7 @@ namespace nanos {
             {
               //! \bug FIXME flags of priority must be in queue
                if ( _usePriority || _useSmartPriority ) {
-                  WDPriorityQueue<> *q = (WDPriorityQueue<> *) wd->getMyQueue();
+                  WDPriorityPool *q = (WDPriorityPool *) wd->getMyQueue();
                   return q? q->reorderWD( wd ) : true;
                } else {
                   return true;
@@ -236,6 +270,8 @@ namespace nanos {
 
       bool DistributedBFPolicy::_usePriority = true;
       bool DistributedBFPolicy::_useSmartPriority = false;
+      bool DistributedBFPolicy::_usePriorityHeap = false;
+      bool DistributedBFPolicy::_useWSDeque = false;
 
       class DistributedBFSchedPlugin : public Plugin
       {
@@ -253,7 +289,11 @@ namespace nanos {
                cfg.registerConfigOption ( "schedule-smart-priority", NEW Config::FlagOption( DistributedBFPolicy::_useSmartPriority ), "Smart priority queue propagates high priorities to predecessors");
                cfg.registerArgOption( "schedule-smart-priority", "schedule-smart-priority" );
 
-               
+               cfg.registerConfigOption ( "schedule-priority-heap", NEW Config::FlagOption( DistributedBFPolicy::_usePriorityHeap ), "Priority queue is kept in a binary heap (logarithmic insertion) instead of an ordered list");
+               cfg.registerArgOption( "schedule-priority-heap", "schedule-priority-heap" );
+
+               cfg.registerConfigOption ( "schedule-ws-deque", NEW Config::FlagOption( DistributedBFPolicy::_useWSDeque ), "Lock-free work-stealing deque used as ready task queue (ignored if priorities are enabled)");
+               cfg.registerArgOption( "schedule-ws-deque", "schedule-ws-deque" );
             }
 
             virtual void init() {
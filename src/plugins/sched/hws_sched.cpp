@@ -0,0 +1,300 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "schedule.hpp"
+#include "wddeque.hpp"
+#include "plugin.hpp"
+#include "system.hpp"
+#include "hwloc_decl.hpp"
+
+#include <vector>
+#include <algorithm>
+
+namespace nanos {
+   namespace ext {
+
+      /*! \brief Hierarchical work stealing policy
+       *
+       *  Every thread owns a ready queue, as in the distributed breadth-first
+       *  policy. When its queue is empty, a thread steals from the other threads
+       *  in order of topological distance: threads on the same core, threads
+       *  sharing a cache, threads in the same NUMA node and finally threads in
+       *  other NUMA nodes. Remote steals are only attempted after a number of
+       *  failed nearby rounds, which grows exponentially while remote steals
+       *  keep failing.
+       */
+      class HierarchicalWSPolicy : public SchedulePolicy
+      {
+         public:
+            using SchedulePolicy::queue;
+
+            static const unsigned int NUM_LEVELS = 4;   //!< Same core, shared cache, same NUMA node, remote
+            static const unsigned int REMOTE = NUM_LEVELS - 1;
+
+            static unsigned int _remoteBackoff;         //!< Failed nearby rounds before the first remote steal
+            static unsigned int _maxRemoteBackoff;      //!< Upper bound of the remote steal backoff
+
+         private:
+            /** \brief Hierarchical WS scheduler data associated to each thread
+              */
+            struct ThreadData : public ScheduleThreadData
+            {
+               /*! queue of ready tasks to be executed */
+               WDPool            *_readyQueue;
+               /*! team threads sorted by distance to this thread (team indexes) */
+               std::vector<int>   _victims;
+               /*! _victims[_levelEnd[l-1].._levelEnd[l]) are the victims at distance l */
+               unsigned int       _levelEnd[NUM_LEVELS];
+               /*! team size _victims was computed for */
+               int                _teamSize;
+               /*! next victim to try on each level, so steals are spread among the level */
+               unsigned int       _next[NUM_LEVELS];
+               /*! current number of failed nearby rounds required before a remote steal */
+               unsigned int       _backoff;
+               /*! failed nearby rounds since the last remote steal attempt */
+               unsigned int       _failedRounds;
+
+               ThreadData () : ScheduleThreadData(), _readyQueue( NULL ), _victims(), _teamSize( 0 ),
+                  _backoff( _remoteBackoff ), _failedRounds( 0 )
+               {
+                  _readyQueue = NEW WDDeque( true /* enableDeviceCounter */ );
+                  for ( unsigned int l = 0; l < NUM_LEVELS; l++ ) {
+                     _levelEnd[l] = 0;
+                     _next[l] = 0;
+                  }
+               }
+               virtual ~ThreadData () { delete _readyQueue; }
+            };
+
+            /* disable copy and assigment */
+            explicit HierarchicalWSPolicy ( const HierarchicalWSPolicy & );
+            const HierarchicalWSPolicy & operator= ( const HierarchicalWSPolicy & );
+
+            /*! \brief Returns the topological distance between the CPUs running two threads */
+            static unsigned int getDistance ( BaseThread &thread, BaseThread &victim )
+            {
+               if ( sys._hwloc.isHwlocAvailable() ) {
+                  return sys._hwloc.getCpuDistance( thread.getCpuId(), victim.getCpuId() );
+               }
+               // Without hwloc only the NUMA node of each PE is known
+               if ( thread.runningOn() == victim.runningOn() ) return 0;
+               return thread.runningOn()->getNumaNode() == victim.runningOn()->getNumaNode() ? 2 : REMOTE;
+            }
+
+            /*! \brief Sorts the team threads by distance to the given thread */
+            static void computeVictims ( BaseThread *thread, ThreadData &data )
+            {
+               ThreadTeam *team = thread->getTeam();
+               int size = team->getFinalSize();
+
+               std::vector<int> levels[NUM_LEVELS];
+               for ( int i = 0; i < size; i++ ) {
+                  BaseThread &victim = team->getThread( i );
+                  if ( &victim == thread ) continue;
+                  levels[getDistance( *thread, victim )].push_back( i );
+               }
+
+               data._victims.clear();
+               for ( unsigned int l = 0; l < NUM_LEVELS; l++ ) {
+                  data._victims.insert( data._victims.end(), levels[l].begin(), levels[l].end() );
+                  data._levelEnd[l] = data._victims.size();
+                  // Threads start stealing at different points of each level
+                  data._next[l] = levels[l].empty() ? 0 : thread->getTeamId() % levels[l].size();
+               }
+               data._teamSize = size;
+            }
+
+            /*! \brief Tries to steal a WD from the victims at the given level */
+            static WD * stealFromLevel ( BaseThread *thread, ThreadData &data, unsigned int level )
+            {
+               unsigned int first = level == 0 ? 0 : data._levelEnd[level - 1];
+               unsigned int count = data._levelEnd[level] - first;
+               if ( count == 0 ) return NULL;
+
+               ThreadTeam *team = thread->getTeam();
+               unsigned int start = data._next[level];
+               for ( unsigned int i = 0; i < count; i++ ) {
+                  unsigned int idx = ( start + i ) % count;
+                  BaseThread &victim = team->getThread( data._victims[first + idx] );
+                  if ( victim.getTeam() == NULL ) continue;
+
+                  ThreadData &vdata = ( ThreadData & ) *victim.getTeamData()->getScheduleData();
+                  WD *wd = vdata._readyQueue->pop_back( thread );
+                  if ( wd != NULL ) {
+                     // Next time start from the following victim
+                     data._next[level] = ( idx + 1 ) % count;
+
+                     NANOS_INSTRUMENT ( if ( level == REMOTE ) { )
+                     NANOS_INSTRUMENT (    static nanos_event_key_t key = sys.getInstrumentation()->getInstrumentationDictionary()->getEventKey("steal-remote"); )
+                     NANOS_INSTRUMENT (    nanos_event_value_t value = (nanos_event_value_t) victim.runningOn()->getNumaNode() + 1; )
+                     NANOS_INSTRUMENT (    sys.getInstrumentation()->raisePointEvents( 1, &key, &value ); )
+                     NANOS_INSTRUMENT ( } )
+                     return wd;
+                  }
+               }
+               return NULL;
+            }
+
+         public:
+            // constructor
+            HierarchicalWSPolicy() : SchedulePolicy ( "Hierarchical WS" ) {}
+
+            // destructor
+            virtual ~HierarchicalWSPolicy() {}
+
+            virtual size_t getTeamDataSize () const { return 0; }
+            virtual size_t getThreadDataSize () const { return sizeof(ThreadData); }
+
+            virtual ScheduleTeamData * createTeamData ()
+            {
+               return 0;
+            }
+
+            virtual ScheduleThreadData * createThreadData ()
+            {
+               return NEW ThreadData();
+            }
+
+            /*!
+            *  \brief Enqueue a work descriptor in the readyQueue of the passed thread
+            *  \param thread pointer to the thread to which readyQueue the task must be appended
+            *  \param wd a reference to the work descriptor to be enqueued
+            *  \sa ThreadData, WD and BaseThread
+            */
+            virtual void queue ( BaseThread *thread, WD &wd )
+            {
+               BaseThread *targetThread = wd.isTiedTo();
+               if ( targetThread ) targetThread->addNextWD(&wd);
+               else {
+                  ThreadData &data = ( ThreadData & ) *thread->getTeamData()->getScheduleData();
+                  data._readyQueue->push_front( &wd );
+                  sys.getThreadManager()->unblockThread(thread);
+               }
+            }
+
+            /*!
+            *  \brief Enqueue a batch of work descriptors, one readyQueue push per
+            *  run of WDs targeting the same thread
+            */
+            virtual void queue ( BaseThread ** threads, WD ** wds, size_t numElems )
+            {
+               size_t first = 0;
+               while ( first < numElems ) {
+                  BaseThread *thread = threads[first];
+                  size_t last = first + 1;
+                  while ( last < numElems && threads[last] == thread ) last++;
+
+                  ThreadData &data = ( ThreadData & ) *thread->getTeamData()->getScheduleData();
+                  data._readyQueue->push_front( &wds[first], last - first );
+                  sys.getThreadManager()->unblockThread(thread);
+
+                  first = last;
+               }
+            }
+
+            /*! Tied WDs go to their thread's next WD instead of a readyQueue */
+            bool isValidForBatch ( const WD * wd ) const
+            {
+               return wd->isTiedTo() == NULL;
+            }
+
+            /*!
+            *  \brief Function called when a new task must be created: the new created task
+            *          is directly queued (Breadth-First policy)
+            */
+            virtual WD * atSubmit ( BaseThread *thread, WD &newWD )
+            {
+               queue(thread,newWD);
+
+               return 0;
+            }
+
+            virtual WD *atIdle ( BaseThread *thread, int numSteal );
+      };
+
+      /*!
+       *  \brief Function called by the scheduler when a thread becomes idle to schedule it: implements the
+       *  hierarchical stealing
+       *  \param thread pointer to the thread to be scheduled
+       *  \sa BaseThread
+       */
+      WD * HierarchicalWSPolicy::atIdle ( BaseThread *thread, int numSteal )
+      {
+         ThreadData &data = ( ThreadData & ) *thread->getTeamData()->getScheduleData();
+
+         //! First try to schedule the thread with a task from its queue
+         WD *wd = data._readyQueue->pop_front( thread );
+         if ( wd != NULL ) return wd;
+
+         if ( data._teamSize != (int) thread->getTeam()->getFinalSize() ) computeVictims( thread, data );
+
+         //! Then steal from the closest threads
+         for ( unsigned int l = 0; l < REMOTE; l++ ) {
+            if ( ( wd = stealFromLevel( thread, data, l ) ) != NULL ) {
+               data._failedRounds = 0;
+               return wd;
+            }
+         }
+
+         //! Cross NUMA nodes only after enough failed nearby rounds
+         if ( ++data._failedRounds < data._backoff ) return NULL;
+         data._failedRounds = 0;
+
+         if ( ( wd = stealFromLevel( thread, data, REMOTE ) ) != NULL ) {
+            data._backoff = _remoteBackoff;
+         } else {
+            data._backoff = std::min( data._backoff * 2, _maxRemoteBackoff );
+         }
+
+         return wd;
+      }
+
+      unsigned int HierarchicalWSPolicy::_remoteBackoff = 4;
+      unsigned int HierarchicalWSPolicy::_maxRemoteBackoff = 256;
+
+      class HierarchicalWSSchedPlugin : public Plugin
+      {
+         public:
+            HierarchicalWSSchedPlugin() : Plugin( "Hierarchical work stealing scheduling Plugin",1 ) {}
+
+            virtual void config( Config& cfg )
+            {
+               cfg.setOptionsSection( "HWS module", "Hierarchical (topology aware) work stealing scheduling module" );
+
+               cfg.registerConfigOption ( "hws-remote-backoff", NEW Config::UintVar( HierarchicalWSPolicy::_remoteBackoff ),
+                     "Failed nearby steal rounds before stealing from another NUMA node (default = 4)" );
+               cfg.registerArgOption( "hws-remote-backoff", "hws-remote-backoff" );
+
+               cfg.registerConfigOption ( "hws-max-remote-backoff", NEW Config::UintVar( HierarchicalWSPolicy::_maxRemoteBackoff ),
+                     "Maximum failed nearby steal rounds before stealing from another NUMA node (default = 256)" );
+               cfg.registerArgOption( "hws-max-remote-backoff", "hws-max-remote-backoff" );
+            }
+
+            virtual void init() {
+               if ( HierarchicalWSPolicy::_remoteBackoff == 0 ) HierarchicalWSPolicy::_remoteBackoff = 1;
+               if ( HierarchicalWSPolicy::_maxRemoteBackoff < HierarchicalWSPolicy::_remoteBackoff )
+                  HierarchicalWSPolicy::_maxRemoteBackoff = HierarchicalWSPolicy::_remoteBackoff;
+               sys.setDefaultSchedulePolicy(NEW HierarchicalWSPolicy());
+            }
+      };
+
+   }
+}
+
+DECLARE_PLUGIN("sched-hws",nanos::ext::HierarchicalWSSchedPlugin);
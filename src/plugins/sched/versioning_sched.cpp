@@ -28,6 +28,9 @@
 
 #include <math.h>
 #include <limits>
+#include <map>
+#include <fstream>
+#include <sstream>
 
 
 namespace nanos {
@@ -98,6 +101,23 @@ namespace ext
    typedef std::vector<WDExecRecord> WDExecInfoData;
    typedef HashMap< WDExecInfoKey, WDExecInfoData, false, 257, WDExecInfoHashKey > WDExecInfo;
 
+   /*
+    * Execution time profiles kept across runs (see --versioning-profile). WDExecInfoKey is only
+    * meaningful inside one run, so profiles are keyed by < task description, paramsSize > and
+    * each version is identified by the name of its device.
+    */
+   struct WDProfileRecord {
+      std::string             _device;
+      double                  _elapsedTime;
+      int                     _numRecords;
+   };
+
+   typedef std::pair< std::string, size_t > WDProfileKey;
+   typedef std::vector<WDProfileRecord> WDProfileData;
+   typedef std::map< WDProfileKey, WDProfileData > WDProfiles;
+
+#define PROFILE_HEADER  "# nanox versioning profile 1"
+
 
    typedef enum {
       NANOS_SCHED_VER_NULL_EVENT,                        /* 0 */
@@ -261,6 +281,7 @@ namespace ext
                WDBestRecord               _wdExecBest;
                WDExecInfo                 _wdExecStats;
                std::set<WDExecInfoKey>    _wdExecStatsKeys;
+               std::map< WDExecInfoKey, WDProfileKey > _wdProfileKeys;
                ResourceMap                _executionMap;
 
                static Lock                _bestLock;
@@ -268,7 +289,8 @@ namespace ext
 
                WDDeque *                  _readyQueue;
 
-               TeamData ( unsigned int size ) : ScheduleTeamData(), _wdExecBest(), _wdExecStats(), _wdExecStatsKeys(), _executionMap( size )
+               TeamData ( unsigned int size ) : ScheduleTeamData(), _wdExecBest(), _wdExecStats(), _wdExecStatsKeys(),
+                  _wdProfileKeys(), _executionMap( size )
                {
                   unsigned int i;
                   for ( i = 0; i < size; i++ ) {
@@ -289,7 +311,10 @@ namespace ext
                }
 
 
-               void initExecInfoData ( WDExecInfoData & data, WD * wd )
+               /*
+                * Returns true if the records were seeded from a saved profile
+                */
+               bool initExecInfoData ( WDExecInfoData & data, WD * wd )
                {
                   unsigned int numVersions = wd->getNumDevices();
 
@@ -324,6 +349,11 @@ namespace ext
                      }
                   }
 
+                  bool profiled = false;
+                  if ( !_profileFile.empty() && wd->getDescription() != NULL ) {
+                     profiled = applyProfile( data, wd );
+                  }
+
                   _statsLock.release();
 
                   WDExecInfoKey key = std::make_pair( wd->getVersionGroupId(), wd->getParamsSize() );
@@ -331,6 +361,90 @@ namespace ext
 
                   fatal_cond( !compatible, "Error: there is no suitable device in the system to run the submitted task.");
 
+                  return profiled;
+               }
+
+
+               /*
+                * Seeds the records of a new task type with the times saved by a previous run, so that
+                * its versions do not have to be explored again. Seeded records count as _minRecordTrial
+                * records at most, so the times of this run soon weigh in. _statsLock must be held.
+                */
+               bool applyProfile ( WDExecInfoData & data, WD * wd )
+               {
+                  unsigned int numVersions = wd->getNumDevices();
+                  DeviceData **devices = wd->getDevices();
+
+                  WDExecInfoKey key = std::make_pair( wd->getVersionGroupId(), wd->getParamsSize() );
+                  WDProfileKey profileKey = std::make_pair( std::string( wd->getDescription() ), wd->getParamsSize() );
+                  _wdProfileKeys[key] = profileKey;
+
+                  WDProfileData &profile = _profiles[profileKey];
+
+                  bool matches = ( profile.size() == numVersions );
+                  for ( unsigned int i = 0; matches && i < numVersions; i++ ) {
+                     matches = ( profile[i]._device == devices[i]->getDevice()->getName() );
+                  }
+
+                  if ( !matches ) {
+                     // Unknown task type, or its versions have changed since the profile was saved
+                     profile.resize( numVersions );
+                     for ( unsigned int i = 0; i < numVersions; i++ ) {
+                        profile[i]._device = devices[i]->getDevice()->getName();
+                        profile[i]._elapsedTime = 0.0;
+                        profile[i]._numRecords = 0;
+                     }
+                     return false;
+                  }
+
+                  bool applied = false;
+
+                  for ( unsigned int i = 0; i < numVersions; i++ ) {
+                     if ( profile[i]._numRecords <= 0 || sys.getNumWorkers( devices[i] ) == 0 ) continue;
+
+                     ProcessingElement *pe = NULL;
+                     for ( int w = 0; w < sys.getNumWorkers() && pe == NULL; w++ ) {
+                        ProcessingElement *candidate = sys.getWorker( w )->runningOn();
+                        if ( candidate->supports( *devices[i]->getDevice() ) ) pe = candidate;
+                     }
+                     if ( pe == NULL ) continue;
+
+                     int records = std::max( std::min( profile[i]._numRecords, _minRecordTrial ), 1 );
+                     data[i]._pe = pe;
+                     data[i]._elapsedTime = profile[i]._elapsedTime;
+                     data[i]._lastElapsedTime = profile[i]._elapsedTime;
+                     data[i]._numRecords = records;
+                     data[i]._numAssigned = records;
+                     applied = true;
+
+                     debug( "[versioning] Profiled record for key ("
+                           + toString<unsigned long>( key.first ) + ", " + toString<size_t>( key.second )
+                           + ") vId " + toString<unsigned int>( i ) + ": T=" + toString<double>( data[i]._elapsedTime ) );
+                  }
+
+                  return applied;
+               }
+
+               /*
+                * Copies the records of this run into the profiles to be saved
+                */
+               void updateProfiles ()
+               {
+                  _statsLock.acquire();
+
+                  for ( std::map< WDExecInfoKey, WDProfileKey >::iterator it = _wdProfileKeys.begin(); it != _wdProfileKeys.end(); it++ ) {
+                     WDExecInfoData &data = _wdExecStats[it->first];
+                     WDProfileData &profile = _profiles[it->second];
+
+                     for ( unsigned int i = 0; i < data.size() && i < profile.size(); i++ ) {
+                        if ( data[i]._pe != NULL && data[i]._numRecords > 0 ) {
+                           profile[i]._elapsedTime = data[i]._elapsedTime;
+                           profile[i]._numRecords = data[i]._numRecords;
+                        }
+                     }
+                  }
+
+                  _statsLock.release();
                }
 
 
@@ -399,10 +513,90 @@ namespace ext
       public:
          static bool       _useStack;
          static int        _minRecordTrial;
+         static std::string _profileFile;
+         static WDProfiles  _profiles;
 
-         Versioning() : SchedulePolicy( "Versioning" ) {}
+         Versioning() : SchedulePolicy( "Versioning" ), _profilesLoaded( false ) {}
          virtual ~Versioning () {}
 
+      private:
+         bool              _profilesLoaded;
+
+         /*
+          * Profile file format: a header line and one line per task type, with tab separated fields
+          *    <description> <paramsSize> <numVersions> { <device> <elapsedTime> <numRecords> }
+          */
+         void loadProfiles ()
+         {
+            std::ifstream in( _profileFile.c_str() );
+            // First run, nothing to load yet
+            if ( !in ) return;
+
+            std::string line;
+            if ( !std::getline( in, line ) || line != PROFILE_HEADER ) {
+               warning0( "Ignoring versioning profile " << _profileFile << ": unknown format" );
+               return;
+            }
+
+            while ( std::getline( in, line ) ) {
+               std::istringstream fields( line );
+               std::string description;
+               size_t paramsSize;
+               unsigned int numVersions;
+
+               if ( !std::getline( fields, description, '\t' ) || !( fields >> paramsSize >> numVersions ) ) continue;
+
+               WDProfileData profile( numVersions );
+               bool valid = true;
+               for ( unsigned int i = 0; valid && i < numVersions; i++ ) {
+                  valid = ( fields >> profile[i]._device >> profile[i]._elapsedTime >> profile[i]._numRecords );
+               }
+
+               if ( valid ) _profiles[std::make_pair( description, paramsSize )] = profile;
+            }
+
+            verbose0( "[versioning] Loaded " << _profiles.size() << " task profiles from " << _profileFile );
+         }
+
+         void saveProfiles ()
+         {
+            std::ofstream out( _profileFile.c_str() );
+            if ( !out ) {
+               warning0( "Cannot write versioning profile " << _profileFile );
+               return;
+            }
+
+            out.precision( 12 );
+            out << PROFILE_HEADER << std::endl;
+
+            for ( WDProfiles::iterator it = _profiles.begin(); it != _profiles.end(); it++ ) {
+               const std::string &description = it->first.first;
+               WDProfileData &profile = it->second;
+
+               if ( description.find_first_of( "\t\n" ) != std::string::npos ) continue;
+
+               bool recorded = false;
+               for ( unsigned int i = 0; i < profile.size(); i++ ) recorded = recorded || profile[i]._numRecords > 0;
+               if ( !recorded ) continue;
+
+               out << description << '\t' << it->first.second << '\t' << profile.size();
+               for ( unsigned int i = 0; i < profile.size(); i++ ) {
+                  out << '\t' << profile[i]._device << '\t' << profile[i]._elapsedTime << '\t' << profile[i]._numRecords;
+               }
+               out << std::endl;
+            }
+         }
+
+      public:
+         virtual void atShutdown ()
+         {
+            if ( _profileFile.empty() ) return;
+
+            TeamData &tdata = ( TeamData & ) *myThread->getTeam()->getScheduleData();
+            tdata.updateProfiles();
+            saveProfiles();
+         }
+
       private:
          virtual size_t getTeamDataSize () const { return sizeof( TeamData ); }
          virtual size_t getThreadDataSize () const { return 0; }
@@ -411,6 +605,11 @@ namespace ext
          {
             TeamData *data;
 
+            if ( !_profileFile.empty() && !_profilesLoaded ) {
+               loadProfiles();
+               _profilesLoaded = true;
+            }
+
             unsigned int num = sys.getNumWorkers();
             data = NEW TeamData( num );
 
@@ -778,10 +977,8 @@ namespace ext
             unsigned int numVersions = next->getNumDevices();
             DeviceData **devices = next->getDevices();
 
-            // First record for the given { wdId, paramsSize }
-            if ( data.empty() ) {
-
-               tdata.initExecInfoData( data, next );
+            // First record for the given { wdId, paramsSize }, unless a saved profile gave us some
+            if ( data.empty() && !tdata.initExecInfoData( data, next ) ) {
 
                tdata._statsLock.acquire();
 
@@ -1228,6 +1425,8 @@ namespace ext
 
    bool Versioning::_useStack = false;
    int Versioning::_minRecordTrial = MIN_RECORDS;
+   std::string Versioning::_profileFile;
+   WDProfiles Versioning::_profiles;
    Lock Versioning::TeamData::_bestLock;
    Lock Versioning::TeamData::_statsLock;
 
@@ -1258,6 +1457,13 @@ namespace ext
                   NEW Config::IntegerVar( Versioning::_minRecordTrial ),
                   "Minimum number of task version trials for the versioning policy" );
             cfg.registerArgOption( "versioning-min-trials", "versioning-min-trials" );
+
+            // Set the file where the execution times of each task version are kept across runs
+            cfg.registerConfigOption ( "versioning-profile",
+                  NEW Config::StringVar( Versioning::_profileFile ),
+                  "File the versioning policy loads task version execution times from at start up, and saves them to at shutdown" );
+            cfg.registerArgOption( "versioning-profile", "versioning-profile" );
+            cfg.registerEnvOption( "versioning-profile", "NX_VERSIONING_PROFILE" );
          }
 
          virtual void init()
@@ -40,6 +40,39 @@ class SlicerDynamicFor: public Slicer
       bool dequeue(nanos::WorkDescriptor* wd, nanos::WorkDescriptor** slice);
 };
 
+//! \brief Loop wrapper used when the iteration space is split along a tree
+//!
+//! A slice flagged with thid == 1 is the upper half of a split iteration space. The thread that
+//! got it runs its first chunk and publishes the rest of it as a new sliced WD, so that splits
+//! are submitted by the threads taking them instead of by the owner of the original loop.
+static void dynamicTreeLoop ( void *arg )
+{
+   nanos_loop_info_t *nli = ( nanos_loop_info_t * ) arg;
+
+   if ( nli->thid == 1 ) {
+      nli->thid = 0;
+
+      int64_t _upper = nli->lower + nli->chunk * nli->step - nli->step;
+      if ( ( nli->step > 0 && _upper < nli->upper ) || ( nli->step < 0 && _upper > nli->upper ) ) {
+         WorkDescriptor *work = myThread->getCurrentWD();
+         WorkDescriptor *rest = NULL;
+         sys.duplicateWD( &rest, work );
+         rest->untie();
+
+         nanos_loop_info_t *rest_nli = ( nanos_loop_info_t * ) rest->getData();
+         rest_nli->lower = _upper + nli->step;
+         sys.setupWD( *rest, work );
+
+         debug ( "Publishing split loop " << rest << ":" << rest->getId() << " from slice " << work << ":" << work->getId() );
+
+         nli->upper = _upper;
+         Scheduler::submit( *rest );
+      }
+   }
+
+   ((SMPDD::work_fct)(nli->args))(arg);
+}
+
 void SlicerDynamicFor::submit ( WorkDescriptor &work )
 {
    debug0 ( "Using sliced work descriptor: Dynamic For" );
@@ -49,6 +82,16 @@ void SlicerDynamicFor::submit ( WorkDescriptor &work )
    //! Normalize Chunk size
    nli->chunk = (1 > nli->chunk)? 1 : nli->chunk;
 
+   //! Split the iteration space along a tree when the loop is SMP only (see dynamicTreeLoop)
+   nli->thid = 0;
+   nli->threads = 1;
+   if ( work.getNumDevices() == 1 && work.getDevices()[0]->isCompatible( getSMPDevice() ) ) {
+      SMPDD &dd = ( SMPDD & ) *work.getDevices()[0];
+      nli->args = ( void * ) dd.getWorkFct();
+      nli->threads = myThread->getTeam()->getFinalSize();
+      dd = SMPDD( dynamicTreeLoop );
+   }
+
    work.untie();
    Scheduler::submit ( work );
 }
@@ -66,8 +109,30 @@ bool SlicerDynamicFor::dequeue(nanos::WorkDescriptor* wd, nanos::WorkDescriptor*
    bool empty = (( nli->step > 0 ) && (nli->lower > nli->upper )) ? true : false;
    empty = empty || (( nli->step < 0 ) && (nli->lower < nli->upper )) ? true : false;
 
+   int64_t _niters = empty ? 0 : ((( nli->upper - nli->lower ) / nli->step ) + 1 );
+
    if ( (_upper >= nli->upper) || empty ) {
       *slice = wd; retval = true;
+   } else if ( nli->threads > 1 && _niters >= 2 * nli->threads * nli->chunk ) {
+      //! Hand the upper half of the iteration space, and half of the threads it was meant for,
+      //! over to the dequeuing thread, which publishes it as another sliced WD
+      int64_t _half = nli->lower + ( _niters / 2 ) * nli->step - nli->step;
+
+      WorkDescriptor *nwd = NULL;
+      sys.duplicateWD( &nwd, wd );
+      nwd->untie();
+
+      int threads = nli->threads;
+      nli->upper = _half;
+      nli->threads = threads / 2;
+
+      nli = ( nanos_loop_info_t * ) nwd->getData();
+      nli->lower = _half + nli->step;
+      nli->threads = threads - threads / 2;
+      nli->thid = 1;
+      sys.setupWD(*nwd, wd );
+
+      *slice = nwd;
    } else {
       WorkDescriptor *nwd = NULL;
       sys.duplicateWD( &nwd, wd );
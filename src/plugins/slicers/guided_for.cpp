@@ -40,6 +40,41 @@ class SlicerGuidedFor: public Slicer
       bool dequeue ( WorkDescriptor *wd, WorkDescriptor **slice );
 };
 
+//! \brief Loop wrapper used when the iteration space is split along a tree
+//!
+//! A slice flagged with thid == 1 is the upper half of a split iteration space, meant for
+//! nli->threads threads. The thread that got it runs its first chunk and publishes the rest
+//! of it as a new sliced WD, so the loop owner does not have to submit every split itself.
+static void guidedTreeLoop ( void *arg )
+{
+   nanos_loop_info_t *nli = ( nanos_loop_info_t * ) arg;
+
+   if ( nli->thid == 1 ) {
+      nli->thid = 0;
+
+      int64_t _niters = ((( nli->upper - nli->lower) / nli->step ) + 1 );
+      int64_t _chunk = std::max( _niters / ( 2 * nli->threads ), nli->chunk );
+      int64_t _upper = nli->lower + _chunk * nli->step ;
+
+      if ( _upper < nli->upper ) {
+         WorkDescriptor *work = myThread->getCurrentWD();
+         WorkDescriptor *rest = NULL;
+         sys.duplicateWD( &rest, work );
+
+         nanos_loop_info_t *rest_nli = ( nanos_loop_info_t * ) rest->getData();
+         rest_nli->lower = _upper + nli->step;
+         sys.setupWD( *rest, work );
+
+         debug ( "Publishing split loop " << rest << ":" << rest->getId() << " from slice " << work << ":" << work->getId() );
+
+         nli->upper = _upper;
+         Scheduler::submit( *rest );
+      }
+   }
+
+   ((SMPDD::work_fct)(nli->args))(arg);
+}
+
 void SlicerGuidedFor::submit ( WorkDescriptor &work )
 {
    debug0 ( "Using sliced work descriptor: Guided For" );
@@ -60,6 +95,14 @@ void SlicerGuidedFor::submit ( WorkDescriptor &work )
    }
    ensure(nli->threads > 0, "Slicer has computed an invalid number of threads");
 
+   //! Split the iteration space along a tree when the loop is SMP only (see guidedTreeLoop)
+   nli->thid = 0;
+   if ( work.getNumDevices() == 1 && work.getDevices()[0]->isCompatible( getSMPDevice() ) ) {
+      SMPDD &dd = ( SMPDD & ) *work.getDevices()[0];
+      nli->args = ( void * ) dd.getWorkFct();
+      dd = SMPDD( guidedTreeLoop );
+   }
+
    //! in order to submit the work.
    Scheduler::submit ( work );
 }
@@ -80,6 +123,25 @@ bool SlicerGuidedFor::dequeue(nanos::WorkDescriptor* wd, nanos::WorkDescriptor**
 
    if ( (_upper >= nli->upper) || empty ) {
       *slice = wd; retval = true;
+   } else if ( nli->threads > 1 && _niters >= 4 * _chunk ) {
+      //! Hand the upper half of the iteration space, and half of the threads it was meant for,
+      //! over to the dequeuing thread, which publishes it as another sliced WD
+      int64_t _half = nli->lower + ( _niters / 2 ) * nli->step - nli->step;
+
+      WorkDescriptor *nwd = NULL;
+      sys.duplicateWD( &nwd, wd );
+
+      int threads = nli->threads;
+      nli->upper = _half;
+      nli->threads = threads / 2;
+
+      nli = ( nanos_loop_info_t * ) nwd->getData();
+      nli->lower = _half + nli->step;
+      nli->threads = threads - threads / 2;
+      nli->thid = 1;
+      sys.setupWD(*nwd, wd );
+
+      *slice = nwd;
    } else {
       WorkDescriptor *nwd = NULL;
       sys.duplicateWD( &nwd, wd );
@@ -214,8 +214,7 @@ void SlicerStaticFor::submit ( WorkDescriptor &work )
    work.tieTo( first_thread );
    if ( mythread == &first_thread ) {
       if ( Scheduler::inlineWork( &work, false ) ) {
-         work.~WorkDescriptor();
-         delete[] (char *) &work;
+         WorkDescriptor::freeChunk( &work );
       }
    }
    else
@@ -0,0 +1,136 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "throttle_decl.hpp"
+#include "system.hpp"
+#include "plugin.hpp"
+#include "config.hpp"
+#include "atomic.hpp"
+#include "dataaccess.hpp"
+
+
+namespace nanos {
+   namespace ext {
+
+      /*! \class FootprintThrottle
+       *  \brief Throttle policy based on the data footprint of the live tasks
+       *
+       *  Each task submitted with dependences accounts the bytes of its declared data accesses
+       *  until it finishes. No more tasks are created while the bytes of the live tasks exceed
+       *  the limit, so that the working set of the created tasks stays within a memory (or
+       *  cache) budget. Data accessed by several live tasks is accounted once per task.
+       */
+      class FootprintThrottle: public ThrottlePolicy
+      {
+
+         private:
+            size_t            _limit;
+            Atomic<size_t>    _liveBytes;
+
+            FootprintThrottle ( const FootprintThrottle & );
+            const FootprintThrottle & operator= ( const FootprintThrottle & );
+
+         public:
+            //must be public: used in the plugin
+            static const size_t _defaultLimit;
+
+            FootprintThrottle( size_t actualLimit = _defaultLimit ) : _limit( actualLimit ), _liveBytes( 0 ) {}
+
+            void setLimit( size_t limit ) { _limit = limit; }
+
+            bool throttleIn();
+            void throttleSubmit( WD &wd, size_t numDataAccesses, DataAccess *dataAccesses );
+            void throttleFinish( WD &wd );
+
+            ~FootprintThrottle() {}
+      };
+
+      const size_t FootprintThrottle::_defaultLimit = 512 * 1024 * 1024;
+
+      bool FootprintThrottle::throttleIn()
+      {
+         if ( _liveBytes.value() > _limit ) {
+            return false;
+         }
+
+         return true;
+      }
+
+      void FootprintThrottle::throttleSubmit( WD &wd, size_t numDataAccesses, DataAccess *dataAccesses )
+      {
+         size_t bytes = 0;
+         for ( size_t i = 0; i < numDataAccesses; i++ ) {
+            short dims = dataAccesses[i].getNumDimensions();
+            nanos_region_dimension_internal_t const *dimensions = dataAccesses[i].getDimensions();
+            if ( dims == 0 ) continue;
+
+            // Dimension 0 is expressed in bytes, only the accessed part of each dimension counts
+            size_t accessed = dimensions[0].accessed_length;
+            for ( short d = 1; d < dims; d++ ) accessed *= dimensions[d].accessed_length;
+            bytes += accessed;
+         }
+
+         if ( bytes == 0 ) return;
+
+         wd.setFootprint( bytes );
+         _liveBytes += bytes;
+      }
+
+      void FootprintThrottle::throttleFinish( WD &wd )
+      {
+         size_t bytes = wd.getFootprint();
+         if ( bytes == 0 ) return;
+
+         wd.setFootprint( 0 );
+         _liveBytes -= bytes;
+      }
+
+      //factory
+      static FootprintThrottle * createFootprintThrottle( size_t actualLimit )
+      {
+         return NEW FootprintThrottle( actualLimit );
+      }
+
+
+      class FootprintThrottlePlugin : public Plugin
+      {
+         private:
+            size_t _actualLimit;
+
+         public:
+            FootprintThrottlePlugin() : Plugin( "Data Footprint Throttle Plugin",1 ), _actualLimit( FootprintThrottle::_defaultLimit ) {}
+
+            virtual void config( Config &cfg )
+            {
+               cfg.setOptionsSection( "Footprint throttle", "Scheduling throttle policy based on the data footprint of the live tasks" );
+               cfg.registerConfigOption ( "throttle-footprint",
+                     NEW Config::SizeVar( _actualLimit ),
+                     "Defines the bytes of declared data accesses of the live tasks allowed (512M)" );
+               cfg.registerArgOption ( "throttle-footprint", "throttle-footprint" );
+            }
+
+            virtual void init() {
+               sys.setThrottlePolicy( createFootprintThrottle( _actualLimit ));
+            }
+      };
+
+   }
+}
+
+DECLARE_PLUGIN("throttle-footprint",nanos::ext::FootprintThrottlePlugin);
@@ -26,17 +26,45 @@
 namespace nanos {
    namespace ext {
 
+      /*! \brief Checks that a number of tasks is less or equal than a limit
+       *
+       *  The task counters are sharded, so the number of tasks is read through a getter instead
+       *  of checking a single variable.
+       */
+      class NumTasksConditionChecker : public ConditionChecker
+      {
+         public:
+            typedef int (*ntask_getter_t)( void ) ;
+         private:
+            ntask_getter_t  _getNumTasks;
+            int             _limit;
+         public:
+            NumTasksConditionChecker() : ConditionChecker(), _getNumTasks( NULL ), _limit( 0 ) {}
+            NumTasksConditionChecker( ntask_getter_t getter, int limit ) : ConditionChecker(), _getNumTasks( getter ), _limit( limit ) {}
+            NumTasksConditionChecker ( const NumTasksConditionChecker & cc ) : ConditionChecker( cc ),
+               _getNumTasks( cc._getNumTasks ), _limit( cc._limit ) {}
+            NumTasksConditionChecker& operator=( const NumTasksConditionChecker & cc )
+            {
+               _getNumTasks = cc._getNumTasks;
+               _limit = cc._limit;
+               return *this;
+            }
+            virtual ~NumTasksConditionChecker() {}
+
+            virtual bool checkCondition() { return _getNumTasks() <= _limit; }
+      };
+
       class HysteresisThrottle: public ThrottlePolicy
       {
          private:
-            typedef int (*ntask_getter_t)( void ) ;
+            typedef NumTasksConditionChecker::ntask_getter_t ntask_getter_t;
             static int get_total_tasks (void) { return sys.getTaskNum(); }
             static int get_ready_tasks (void) { return sys.getReadyNum(); }
          private:
             int                                                  _upper;
             int                                                  _lower;
             std::string                                          _type;
-            MultipleSyncCond<LessOrEqualConditionChecker<int> > *_syncCond;
+            MultipleSyncCond<NumTasksConditionChecker>           *_syncCond;
             ntask_getter_t                                       _get_num_tasks;
 
             HysteresisThrottle ( const HysteresisThrottle & );
@@ -50,13 +78,13 @@ namespace nanos {
                _syncCond( NULL )
             {
                if ( _type == "total" ) {
-                  _syncCond = (MultipleSyncCond< LessOrEqualConditionChecker<int> >*) new MultipleSyncCond< LessOrEqualConditionChecker<int> >(LessOrEqualConditionChecker<int>(sys.getSchedulerStats().getTotalTasksAddr(), lower * sys.getNumThreads())) ;
                   _get_num_tasks = &get_total_tasks;
                } else if ( _type == "ready" ) {
-                  _syncCond = (MultipleSyncCond< LessOrEqualConditionChecker<int> >*) new MultipleSyncCond< LessOrEqualConditionChecker<int> >(LessOrEqualConditionChecker<int>(sys.getSchedulerStats().getReadyTasksAddr(), lower * sys.getNumThreads())) ;
                   _get_num_tasks = &get_ready_tasks;
                } else fatal0("Unknow throttle type");
 
+               _syncCond = new MultipleSyncCond<NumTasksConditionChecker>( NumTasksConditionChecker( _get_num_tasks, _lower ) );
+
                verbose0( "Throttle hysteresis created");
                verbose0( "   type of tasks: " << _type );
                verbose0( "   lower bound: " << lower * sys.getNumThreads() );
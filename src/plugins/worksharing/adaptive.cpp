@@ -0,0 +1,236 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "nanos-int.h"
+#include "atomic.hpp"
+#include "lock.hpp"
+#include "plugin.hpp"
+#include "system.hpp"
+#include "worksharing_decl.hpp"
+
+namespace nanos {
+namespace ext {
+
+//! \brief Range of chunks owned by one thread of the team
+//!
+//! The owner takes chunks from the front of the range, thieves cut the back half of it. Each
+//! range is padded to its own cache line so that the owner does not share it with its neighbours.
+typedef struct {
+   Lock                      lock;         // protects next and end
+   volatile int64_t          next;         // first chunk not handed out yet
+   volatile int64_t          end;          // one past the last chunk of the range
+   char                      pad[64 - sizeof(Lock) - 2 * sizeof(int64_t)];
+} WorkSharingAdaptiveRange;
+
+typedef struct {
+   int64_t                   lowerBound;   // loop lower bound
+   int64_t                   upperBound;   // loop upper bound
+   int64_t                   loopStep;     // loop step
+   int64_t                   chunkSize;    // loop chunk size
+   int64_t                   numOfChunks;  // number of chunks for the loop
+   int                       numRanges;    // number of per-thread ranges
+   WorkSharingAdaptiveRange *ranges;       // per-thread ranges of chunks
+} WorkSharingAdaptiveLoopInfo;
+
+//! \brief Loop worksharing with per-thread chunk ranges and steal-half balancing
+//!
+//! Chunks are pre-partitioned into one contiguous range per team member, so that in the common
+//! case a thread only touches its own range. A thread that runs out of chunks steals the upper
+//! half of the remaining chunks of another thread, which keeps irregular loops balanced without
+//! a shared chunk counter.
+class WorkSharingAdaptiveFor : public WorkSharing {
+
+      //! \brief Take the next chunk from the front of a range
+      bool takeChunk ( WorkSharingAdaptiveRange &range, int64_t &chunk )
+      {
+         bool taken = false;
+
+         range.lock.acquire();
+         if ( range.next < range.end ) {
+            chunk = range.next++;
+            taken = true;
+         }
+         range.lock.release();
+
+         return taken;
+      }
+
+      //! \brief Steal half of the chunks left in another range
+      //! \return the first stolen chunk, the rest (if any) is moved to the thief's range
+      bool stealChunk ( WorkSharingAdaptiveLoopInfo *loop_data, int me, int64_t &chunk )
+      {
+         for ( int i = 1; i < loop_data->numRanges; i++ ) {
+            WorkSharingAdaptiveRange &victim = loop_data->ranges[( me + i ) % loop_data->numRanges];
+
+            // Skip empty ranges without bouncing their cache line
+            if ( victim.next >= victim.end ) continue;
+
+            int64_t stolen = 0, stolen_end = 0;
+            victim.lock.acquire();
+            int64_t left = victim.end - victim.next;
+            if ( left > 0 ) {
+               stolen = ( left + 1 ) / 2;
+               stolen_end = victim.end;
+               victim.end = stolen_end - stolen;
+            }
+            victim.lock.release();
+
+            if ( stolen == 0 ) continue;
+
+            chunk = stolen_end - stolen;
+            if ( stolen > 1 ) {
+               WorkSharingAdaptiveRange &mine = loop_data->ranges[me];
+               mine.lock.acquire();
+               mine.next = chunk + 1;
+               mine.end = stolen_end;
+               mine.lock.release();
+            }
+            return true;
+         }
+         return false;
+      }
+
+      //! \brief create a loop descriptor
+      //! \return only one thread per loop will get 'true' (single like behaviour)
+      bool create( nanos_ws_desc_t **wsd, nanos_ws_info_t *info )
+      {
+         nanos_ws_info_loop_t *loop_info = (nanos_ws_info_loop_t *) info;
+         bool single = false;
+
+         *wsd = myThread->getTeamWorkSharingDescriptor( &single );
+         if ( single ) {
+            WorkSharingAdaptiveLoopInfo *loop_data = NEW WorkSharingAdaptiveLoopInfo();
+
+            // Computing Lower and upper bound. Loop step.
+            loop_data->lowerBound = loop_info->lower_bound;
+            loop_data->upperBound = loop_info->upper_bound;
+            loop_data->loopStep   = loop_info->loop_step;
+
+            // Computing chunk size
+            int64_t chunk_size = std::max<int64_t>( loop_info->chunk_size, 1 );
+            loop_data->chunkSize  = chunk_size;
+
+            // Computing number of chunks
+            int64_t niters = (((loop_info->upper_bound - loop_info->lower_bound) / loop_info->loop_step ) + 1 );
+            int64_t chunks = std::max<int64_t>( niters / chunk_size, 0 );
+            if ( niters > 0 && niters % chunk_size != 0 ) chunks++;
+            loop_data->numOfChunks = chunks;
+
+            // Splitting chunks in one contiguous range per team member
+            int nranges = std::max<int>( myThread->getTeam()->getFinalSize(), 1 );
+            loop_data->numRanges = nranges;
+            loop_data->ranges = NEW WorkSharingAdaptiveRange[nranges];
+
+            int64_t base = chunks / nranges, extra = chunks % nranges, start = 0;
+            for ( int i = 0; i < nranges; i++ ) {
+               loop_data->ranges[i].next = start;
+               start += base + ( i < extra ? 1 : 0 );
+               loop_data->ranges[i].end = start;
+            }
+
+            (*wsd)->data = loop_data;
+
+            memoryFence();     // Split initialization phase (before) from make it visible (after)
+
+            (*wsd)->ws = this; // Once 'ws' field has a value, any other thread can use the structure
+         }
+
+         // Wait until worksharing descriptor is initialized
+         while ( (*wsd)->ws == NULL ) {;}
+
+         return single;
+      }
+
+      //! \brief Get next chunk of iterations
+      void nextItem( nanos_ws_desc_t *wsd, nanos_ws_item_t *item )
+      {
+         nanos_ws_item_loop_t        *loop_item = ( nanos_ws_item_loop_t *) item;
+         WorkSharingAdaptiveLoopInfo *loop_data = ( WorkSharingAdaptiveLoopInfo *) wsd->data;
+
+         // Threads joining the team after the loop was created share a range
+         int me = myThread->getTeamId() % loop_data->numRanges;
+         WorkSharingAdaptiveRange &mine = loop_data->ranges[me];
+
+         int64_t mychunk;
+         if ( !takeChunk( mine, mychunk ) && !stealChunk( loop_data, me, mychunk ) ) {
+            loop_item->execute = false;
+            return;
+         }
+
+         // Compute lower and upper bounds
+         loop_item->lower = loop_data->lowerBound
+                          + loop_data->chunkSize * loop_data->loopStep * mychunk;
+         loop_item->upper = loop_item->lower
+                          + loop_data->chunkSize * loop_data->loopStep
+                          - loop_data->loopStep;
+
+         // Check bounds
+         if ( loop_item->upper*loop_data->loopStep > loop_data->upperBound*loop_data->loopStep ) {
+            loop_item->upper = loop_data->upperBound;
+         }
+         ensure( loop_item->lower*loop_data->loopStep <= loop_item->upper*loop_data->loopStep,
+               "Chunk bounds out of range" );
+
+         loop_item->last = ( mychunk == loop_data->numOfChunks - 1 );
+         loop_item->execute = true;
+
+         // Try to acquire more CPUs if there is still work in our own range
+         if ( mine.end - mine.next > 2 ) {
+            ThreadManager *const thread_manager = sys.getThreadManager();
+            if ( thread_manager->isGreedy()) {
+               thread_manager->acquireOne();
+            }
+         }
+      }
+
+      int64_t getItemsLeft( nanos_ws_desc_t *wsd )
+      {
+         WorkSharingAdaptiveLoopInfo *loop_data = (WorkSharingAdaptiveLoopInfo*)wsd->data;
+         int64_t left = 0;
+         for ( int i = 0; i < loop_data->numRanges; i++ ) {
+            left += std::max<int64_t>( loop_data->ranges[i].end - loop_data->ranges[i].next, 0 );
+         }
+         return left;
+      }
+
+      bool instanceOnCreation()
+      {
+         return false;
+      }
+
+      void duplicateWS ( nanos_ws_desc_t *orig, nanos_ws_desc_t **copy) {}
+};
+
+class WorkSharingAdaptiveForPlugin : public Plugin {
+   public:
+      WorkSharingAdaptiveForPlugin () : Plugin("Worksharing plugin for loops using an adaptive (steal-half) policy",1) {}
+     ~WorkSharingAdaptiveForPlugin () {}
+
+      virtual void config( Config& cfg ) {}
+
+      void init ()
+      {
+         sys.registerWorkSharing("adaptive_for", NEW WorkSharingAdaptiveFor() );
+      }
+};
+
+} // namespace ext
+} // namespace nanos
+
+DECLARE_PLUGIN( "worksharing-adaptive", nanos::ext::WorkSharingAdaptiveForPlugin );
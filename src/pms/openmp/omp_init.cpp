@@ -69,6 +69,19 @@ namespace nanos
                              "Configures the number of OpenMP Threads to use" );
          cfg.registerEnvOption("omp-threads","OMP_NUM_THREADS");
 
+         // Task aware locks
+         _taskAwareLocks = false;
+         cfg.registerConfigOption( "omp-task-aware-locks", NEW Config::FlagOption( _taskAwareLocks, true ),
+                             "OpenMP locks block the waiting task instead of spinning its thread" );
+         cfg.registerArgOption( "omp-task-aware-locks", "omp-task-aware-locks" );
+         cfg.registerEnvOption( "omp-task-aware-locks", "NX_OMP_TASK_AWARE_LOCKS" );
+
+         _lockSpins = 100;
+         cfg.registerConfigOption( "omp-lock-spins", NEW Config::PositiveVar( _lockSpins ),
+                             "Number of checks of a task aware lock before blocking the task (default: 100)" );
+         cfg.registerArgOption( "omp-lock-spins", "omp-lock-spins" );
+         cfg.registerEnvOption( "omp-lock-spins", "NX_OMP_LOCK_SPINS" );
+
          // OMP_SCHEDULE
          // OMP_DYNAMIC
          // OMP_NESTED
@@ -81,7 +94,7 @@ namespace nanos
          ws_names[omp_sched_static] = std::string("static_for");
          ws_names[omp_sched_dynamic] = std::string("dynamic_for");
          ws_names[omp_sched_guided] = std::string("guided_for");
-         ws_names[omp_sched_auto] = std::string("static_for");
+         ws_names[omp_sched_auto] = std::string("adaptive_for");
       }
 
 
@@ -95,6 +108,7 @@ namespace nanos
          // Must be allocated through new to avoid problems with the order of
          // initialization of global objects
          globalState = NEW OmpState();
+         globalState->setLocksConfig( _taskAwareLocks, _lockSpins );
          TaskICVs & icvs = globalState->getICVs();
          icvs.setSchedule(LoopSchedule(omp_sched_static));
 
@@ -349,6 +363,7 @@ namespace nanos
          // Must be allocated through new to avoid problems with the order of
          // initialization of global objects
          globalState = NEW OmpState();
+         globalState->setLocksConfig( _taskAwareLocks, _lockSpins );
          TaskICVs & icvs = globalState->getICVs();
 
          int requested_workers = sys.getSMPPlugin()->getRequestedWorkers();
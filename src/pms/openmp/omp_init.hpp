@@ -39,6 +39,8 @@ namespace nanos {
             nanos_ws_t  ws_plugins[NANOS_OMP_WS_TSIZE];
             int _numThreads;
             int _numThreadsOMP;
+            bool _taskAwareLocks;
+            int _lockSpins;
             virtual void start () ;
 
          private:
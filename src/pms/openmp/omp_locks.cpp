@@ -21,13 +21,31 @@
 #include "nanos.h"
 #include "atomic.hpp"
 #include "lock.hpp"
+#include "taskawarelock.hpp"
+#include "omp_wd_data.hpp"
+
+using namespace nanos;
+using namespace nanos::OpenMP;
+
+/*! \brief Whether OpenMP locks are TaskAwareLock objects
+ *
+ *  In that mode the lock word only holds a pointer to the lock, which blocks the waiting task
+ *  instead of spinning its thread. The mode is fixed when the runtime starts.
+ */
+static inline bool taskAwareLocks ()
+{
+   return globalState != NULL && globalState->getTaskAwareLocks();
+}
 
 extern "C"
 {
-   using namespace nanos;
-
    NANOS_API_DEF(void, omp_init_lock, ( omp_lock_t *arg ))
    {
+      if ( taskAwareLocks() ) {
+         *arg = NEW TaskAwareLock( globalState->getLockSpins() );
+         return;
+      }
+
       // NOTE: This assumes Lock is the same size than Void * so nothing has to be allocated
       Lock *lock = (Lock *) arg;
 
@@ -36,28 +54,45 @@ extern "C"
 
    NANOS_API_DEF(void, omp_destroy_lock, ( omp_lock_t *arg ))
    {
+      if ( taskAwareLocks() ) {
+         delete (TaskAwareLock *) *arg;
+         *arg = NULL;
+      }
    }
 
    NANOS_API_DEF(void, omp_set_lock, ( omp_lock_t *arg ))
    {
+      if ( taskAwareLocks() ) {
+         ( (TaskAwareLock *) *arg )->acquire();
+         return;
+      }
+
       Lock &lock = *(Lock *) arg;
       lock++;
    }
 
    NANOS_API_DEF(void, omp_unset_lock,( omp_lock_t *arg ))
    {
+      if ( taskAwareLocks() ) {
+         ( (TaskAwareLock *) *arg )->release();
+         return;
+      }
+
       Lock &lock = *(Lock *) arg;
       lock--;
    }
 
    NANOS_API_DEF(int, omp_test_lock ,( omp_lock_t *arg ))
    {
+      if ( taskAwareLocks() ) return ( (TaskAwareLock *) *arg )->tryAcquire();
+
       Lock &lock = *(Lock *) arg;
       return lock.tryAcquire();
    }
 
    struct __omp_nest_lock {
       Lock lock;
+      TaskAwareLock *taskAwareLock;   // used instead of 'lock' in task aware mode
       nanos_wd_t owner;
       short count;
    };
@@ -65,6 +100,7 @@ extern "C"
    NANOS_API_DEF(void, omp_init_nest_lock, ( omp_nest_lock_t *arg ) )
    {
       struct __omp_nest_lock *nlock = NEW struct __omp_nest_lock();
+      nlock->taskAwareLock = taskAwareLocks() ? NEW TaskAwareLock( globalState->getLockSpins() ) : NULL;
       nlock->owner = NULL;
       nlock->count = 0;
       *arg = nlock;
@@ -73,6 +109,7 @@ extern "C"
    NANOS_API_DEF(void, omp_destroy_nest_lock, ( omp_nest_lock_t *arg ) )
    {
       struct __omp_nest_lock *nlock=( struct __omp_nest_lock * )*arg;
+      delete nlock->taskAwareLock;
       delete nlock;
    }
 
@@ -85,7 +122,8 @@ extern "C"
          // count >=1 is assumed because only the owner can set it
          nlock->count++;
       } else {
-         nlock->lock++;
+         if ( nlock->taskAwareLock != NULL ) nlock->taskAwareLock->acquire();
+         else nlock->lock++;
          // count == 0 is assumed because we just acquired the lock
          nlock->owner = nanos_current_wd();
          nlock->count++;
@@ -100,7 +138,8 @@ extern "C"
       nlock->count--;
       if ( nlock->count == 0 ) {
          nlock->owner = NULL;
-         nlock->lock--;
+         if ( nlock->taskAwareLock != NULL ) nlock->taskAwareLock->release();
+         else nlock->lock--;
       }
    }
 
@@ -113,7 +152,7 @@ extern "C"
          nlock->count++;
          return 1;
       } else {
-         int result = nlock->lock.tryAcquire();
+         int result = nlock->taskAwareLock != NULL ? nlock->taskAwareLock->tryAcquire() : nlock->lock.tryAcquire();
          if ( result != 0 ) {
             // count == 0 is assumed because we just acquired the lock
             nlock->owner = nanos_current_wd();
@@ -123,4 +162,3 @@ extern "C"
       }
    }
 }
-
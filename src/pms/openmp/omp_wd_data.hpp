@@ -169,6 +169,8 @@ namespace nanos {
             TaskICVs    _globalICVs;            /*!< \brief Model's global Internal Control Variables */
             int         _threadLimitVar;        /*!< \brief Maximum number of threads participating in the program */
             int         _maxActiveLevelsVar;    /*!< \brief Maximum number of nested active parallel regions */
+            bool        _taskAwareLocks;        /*!< \brief Whether OpenMP locks block the waiting task instead of its thread */
+            int         _lockSpins;             /*!< \brief Checks of a task aware lock before blocking the task */
 
             /* Not implemented global ICV's */
             // unsigned int _stacksizeVar;
@@ -177,7 +179,8 @@ namespace nanos {
 
          public:
 
-            OmpState() : _globalICVs(), _threadLimitVar(INT_MAX), _maxActiveLevelsVar(INT_MAX) {}
+            OmpState() : _globalICVs(), _threadLimitVar(INT_MAX), _maxActiveLevelsVar(INT_MAX),
+                         _taskAwareLocks(false), _lockSpins(100) {}
             ~OmpState() {}
 
             int getThreadLimit () const { return _threadLimitVar; }
@@ -186,6 +189,10 @@ namespace nanos {
             void setMaxActiveLevels( unsigned int levels ) { _maxActiveLevelsVar = levels; }
 
             TaskICVs & getICVs () { return _globalICVs; }
+
+            bool getTaskAwareLocks () const { return _taskAwareLocks; }
+            int getLockSpins () const { return _lockSpins; }
+            void setLocksConfig ( bool taskAware, int spins ) { _taskAwareLocks = taskAware; _lockSpins = spins; }
       };
 
       extern OmpState *globalState;
@@ -231,6 +231,16 @@ inline void memoryFence ()
 #endif
 }
 
+/*! \brief Hints the processor that the caller is in a spin-wait loop */
+inline void cpuRelax ()
+{
+#if ( defined(__i386__) || defined(__x86_64__) ) && !defined(__MIC__)
+   __asm__ __volatile__("pause" ::: "memory");
+#else
+   __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
 #ifdef HAVE_NEW_GCC_ATOMIC_OPS
 template<typename T>
 inline bool compareAndSwap( T *ptr, T oldval, T  newval )
@@ -174,4 +174,24 @@ bool Hwloc::isCpuAvailable( unsigned int cpu ) const
    return hwloc_get_pu_obj_by_os_index( _hwlocTopology, cpu ) != NULL;
 #endif
 }
+
+unsigned int Hwloc::getCpuDistance( unsigned int cpu1, unsigned int cpu2 ) const
+{
+   if ( cpu1 == cpu2 ) return 0;
+#ifdef HWLOC
+   hwloc_obj_t pu1 = hwloc_get_pu_obj_by_os_index( _hwlocTopology, cpu1 );
+   hwloc_obj_t pu2 = hwloc_get_pu_obj_by_os_index( _hwlocTopology, cpu2 );
+   if ( pu1 == NULL || pu2 == NULL ) return 3;
+
+   hwloc_obj_t common = hwloc_get_common_ancestor_obj( _hwlocTopology, pu1, pu2 );
+   if ( common->type == HWLOC_OBJ_CORE ) return 0;
+   if ( common->type == HWLOC_OBJ_CACHE ) return 1;
+
+   hwloc_obj_t node1 = hwloc_get_ancestor_obj_by_type( _hwlocTopology, HWLOC_OBJ_NODE, pu1 );
+   hwloc_obj_t node2 = hwloc_get_ancestor_obj_by_type( _hwlocTopology, HWLOC_OBJ_NODE, pu2 );
+   return node1 == node2 ? 2 : 3;
+#else
+   return 3;
+#endif
+}
 }
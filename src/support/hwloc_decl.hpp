@@ -63,6 +63,19 @@ class Hwloc {
        */
       bool isCpuAvailable( unsigned int cpu ) const;
 
+      /*!
+       * \brief Returns how close two CPUs are in the machine hierarchy.
+       *
+       * The distance is one of: 0 (same core), 1 (sharing a cache),
+       * 2 (same NUMA node) or 3 (different NUMA nodes).
+       *
+       * If hwloc is not available, only the same CPU is considered close.
+       *
+       * @param cpu1 OS CPU index.
+       * @param cpu2 OS CPU index.
+       */
+      unsigned int getCpuDistance( unsigned int cpu1, unsigned int cpu2 ) const;
+
 };
 
 } // namespace nanos
@@ -49,6 +49,14 @@ inline void Lock::operator-- ( int val )
    release();
 }
 
+inline void Lock::wait ( unsigned int &backoff ) const
+{
+   for ( unsigned int i = 0; i < backoff; i++ ) cpuRelax();
+   if ( backoff < MAX_BACKOFF ) backoff <<= 1;
+
+   while ( getState() == NANOS_LOCK_BUSY ) cpuRelax();
+}
+
 inline void Lock::acquire ( void )
 {
 #ifdef HAVE_NEW_GCC_ATOMIC_OPS
@@ -58,10 +66,10 @@ inline void Lock::acquire ( void )
 
    // Disabling lock instrumentation; do not remove follow code which can be reenabled for testing purposes
    // NANOS_INSTRUMENT( InstrumentState inst(NANOS_ACQUIRING_LOCK) )
-spin:
-   while ( state_ == NANOS_LOCK_BUSY ) {}
-
-   if ( __sync_lock_test_and_set( &state_,NANOS_LOCK_BUSY ) ) goto spin;
+   unsigned int backoff = 1;
+   do {
+      wait( backoff );
+   } while ( __sync_lock_test_and_set( &state_,NANOS_LOCK_BUSY ) );
 
    // NANOS_INSTRUMENT( inst.close() )
 #endif
@@ -75,11 +83,16 @@ inline void Lock::lock()
 inline void Lock::acquire_noinst ( void )
 {
 #ifdef HAVE_NEW_GCC_ATOMIC_OPS
-   while (__atomic_exchange_n( &state_, NANOS_LOCK_BUSY, __ATOMIC_ACQ_REL) == NANOS_LOCK_BUSY ) { }
+   if ( __atomic_load_n(&state_, __ATOMIC_RELAXED) == NANOS_LOCK_FREE &&
+        __atomic_exchange_n( &state_, NANOS_LOCK_BUSY, __ATOMIC_ACQ_REL) == NANOS_LOCK_FREE ) return;
+
+   unsigned int backoff = 1;
+   do {
+      wait( backoff );
+   } while ( __atomic_exchange_n( &state_, NANOS_LOCK_BUSY, __ATOMIC_ACQ_REL) == NANOS_LOCK_BUSY );
 #else
-spin:
-   while ( state_ == NANOS_LOCK_BUSY ) {}
-   if ( __sync_lock_test_and_set( &state_,NANOS_LOCK_BUSY ) ) goto spin;
+   unsigned int backoff = 1;
+   while ( __sync_lock_test_and_set( &state_,NANOS_LOCK_BUSY ) ) wait( backoff );
 #endif
 }
 
@@ -135,6 +148,30 @@ inline bool operator!= ( const Lock& lhs, const Lock& rhs )
 }
 
 
+template <class L>
+inline GenericLockBlock<L>::GenericLockBlock ( L & lock ) : _lock(lock)
+{
+   acquire();
+}
+
+template <class L>
+inline GenericLockBlock<L>::~GenericLockBlock ( )
+{
+   release();
+}
+
+template <class L>
+inline void GenericLockBlock<L>::acquire()
+{
+   _lock.acquire();
+}
+
+template <class L>
+inline void GenericLockBlock<L>::release()
+{
+   _lock.release();
+}
+
 inline LockBlock::LockBlock ( Lock & lock ) : _lock(lock)
 {
    acquire();
@@ -24,11 +24,26 @@
 
 namespace nanos {
 
+   /*! \class Lock
+    *  \brief Test and test-and-set spin lock
+    *
+    *  Waiters spin reading the lock state, so the cache line is shared while the lock is busy,
+    *  and back off exponentially after a failed attempt to take it. The layout is the one of
+    *  nanos_lock_t, which is embedded by the compiler in user code.
+    *
+    *  \see TicketLock and McsLock for fair variants with the same interface
+    */
    class Lock : public nanos_lock_t
    {
       private:
          typedef nanos_lock_state_t state_t;
 
+         /*! Upper bound of the backoff, in cpuRelax() calls */
+         enum { MAX_BACKOFF = 256 };
+
+         /*! \brief Spins until the lock looks free, backing off for a while first */
+         void wait ( unsigned int &backoff ) const;
+
          // disable copy constructor and assignment operator
          Lock( const Lock &lock );
          const Lock & operator= ( const Lock& );
@@ -70,6 +85,26 @@ namespace nanos {
          friend bool operator!= ( const Lock& lhs, const Lock& rhs );
    };
 
+   /*! \class GenericLockBlock
+    *  \brief Holds any lock with the Lock interface (e.g. TicketLock or McsLock) for a scope
+    */
+   template <class L>
+   class GenericLockBlock
+   {
+     private:
+       L & _lock;
+
+       // disable copy-constructor
+       explicit GenericLockBlock ( const GenericLockBlock & );
+
+     public:
+       GenericLockBlock ( L & lock );
+       ~GenericLockBlock ( );
+
+       void acquire();
+       void release();
+   };
+
    class LockBlock
    {
      private:
@@ -0,0 +1,130 @@
+/*************************************************************************************/
+/*      Copyright 2009 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_MCS_LOCK
+#define _NANOS_MCS_LOCK
+
+#include "atomic.hpp"
+#include "debug.hpp"
+#include "mcslock_decl.hpp"
+
+namespace nanos {
+
+inline McsLock::Node * McsLock::getNode ()
+{
+   for ( int i = 0; i < MAX_NESTING; i++ ) {
+      if ( !_myNodes[i].inUse ) {
+         _myNodes[i].inUse = true;
+         return &_myNodes[i];
+      }
+   }
+   fatal0( "Too many McsLock objects held by the same thread" );
+}
+
+inline void McsLock::acquire ()
+{
+   Node *me = getNode();
+   me->next = NULL;
+   me->locked = true;
+
+   Node *prev;
+   do {
+      prev = _tail;
+   } while ( !compareAndSwap( &_tail, prev, me ) );
+
+   if ( prev != NULL ) {
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+      __atomic_store_n( &prev->next, me, __ATOMIC_RELEASE );
+      while ( __atomic_load_n( &me->locked, __ATOMIC_ACQUIRE ) ) cpuRelax();
+#else
+      prev->next = me;
+      while ( me->locked ) cpuRelax();
+      memoryFence();
+#endif
+   }
+
+   _holder = me;
+}
+
+inline bool McsLock::tryAcquire ()
+{
+   if ( _tail != NULL ) return false;
+
+   Node *me = getNode();
+   me->next = NULL;
+   me->locked = true;
+
+   if ( !compareAndSwap( &_tail, (Node *) NULL, me ) ) {
+      me->inUse = false;
+      return false;
+   }
+
+   _holder = me;
+   return true;
+}
+
+inline void McsLock::release ()
+{
+   Node *me = _holder;
+
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+   Node *next = __atomic_load_n( &me->next, __ATOMIC_ACQUIRE );
+#else
+   Node *next = me->next;
+#endif
+   if ( next == NULL ) {
+      // No known successor: either free the lock or wait for the one being queued
+      if ( compareAndSwap( &_tail, me, (Node *) NULL ) ) {
+         me->inUse = false;
+         return;
+      }
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+      while ( ( next = __atomic_load_n( &me->next, __ATOMIC_ACQUIRE ) ) == NULL ) cpuRelax();
+#else
+      while ( ( next = me->next ) == NULL ) cpuRelax();
+#endif
+   }
+
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+   __atomic_store_n( &next->locked, false, __ATOMIC_RELEASE );
+#else
+   memoryFence();
+   next->locked = false;
+#endif
+   me->inUse = false;
+}
+
+inline bool McsLock::isLocked () const
+{
+   return _tail != NULL;
+}
+
+inline void McsLock::operator++ ( int val )
+{
+   acquire();
+}
+
+inline void McsLock::operator-- ( int val )
+{
+   release();
+}
+
+} // namespace nanos
+
+#endif
@@ -0,0 +1,88 @@
+/*************************************************************************************/
+/*      Copyright 2009 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_MCS_LOCK_DECL
+#define _NANOS_MCS_LOCK_DECL
+
+#include <cstddef>
+
+namespace nanos {
+
+   /*! \class McsLock
+    *  \brief Queue lock of Mellor-Crummey and Scott
+    *
+    *  Waiters are linked in a FIFO queue and each one spins on a flag of its own queue node,
+    *  so a release only touches the cache line of the next waiter. Queue nodes come from a
+    *  small per-thread pool, which bounds to MAX_NESTING the number of McsLock objects a
+    *  thread can hold at the same time. The lock must be released by the thread that
+    *  acquired it.
+    */
+   class McsLock
+   {
+      private:
+         enum { MAX_NESTING = 8 };
+
+         typedef struct Node {
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+            Node           *next;      /**< Next waiter in the queue */
+            bool            locked;    /**< Cleared by the predecessor when it hands off the lock */
+#else
+            Node * volatile next;      /**< Next waiter in the queue */
+            volatile bool   locked;    /**< Cleared by the predecessor when it hands off the lock */
+#endif
+            bool            inUse;     /**< Node is queued in some lock (only used by its thread) */
+         } Node;
+
+         static __thread Node    _myNodes[MAX_NESTING];   /**< Queue nodes of the calling thread */
+
+#ifdef HAVE_NEW_GCC_ATOMIC_OPS
+         Node           *_tail;     /**< Last node of the queue, NULL if the lock is free */
+#else
+         Node * volatile _tail;     /**< Last node of the queue, NULL if the lock is free */
+#endif
+         Node           *_holder;   /**< Node of the holder, only accessed by the holder */
+
+         // disable copy constructor and assignment operator
+         McsLock( const McsLock &lock );
+         const McsLock & operator= ( const McsLock& );
+
+         /*! \brief Takes a free node from the pool of the calling thread */
+         static Node * getNode ();
+
+      public:
+         McsLock() : _tail( NULL ), _holder( NULL ) {}
+
+         ~McsLock() {}
+
+         void acquire();
+
+         bool tryAcquire();
+
+         void release();
+
+         bool isLocked () const;
+
+         void operator++ ( int val );
+
+         void operator-- ( int val );
+   };
+
+} // namespace nanos
+
+#endif
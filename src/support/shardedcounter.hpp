@@ -0,0 +1,74 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_SHARDED_COUNTER
+#define _NANOS_SHARDED_COUNTER
+
+#include "shardedcounter_decl.hpp"
+#include "atomic.hpp"
+
+namespace nanos {
+
+inline ShardedCounter::ShardedCounter ( int init )
+{
+   _numShards.value = 1;
+   for ( int i = 0; i < MAX_SHARDS; i++ ) _shards[i].value = 0;
+   _shards[0].value = init;
+}
+
+inline void ShardedCounter::setThreadShard ( unsigned id )
+{
+   _myShard = id % MAX_SHARDS;
+}
+
+inline void ShardedCounter::add ( int val )
+{
+   int shard = _myShard;
+
+   // The first update from a shard not read yet makes it visible to the readers
+   int used = _numShards.value.value();
+   while ( shard >= used && !_numShards.value.cswap( used, shard + 1 ) ) used = _numShards.value.value();
+
+   _shards[shard].value += val;
+}
+
+inline void ShardedCounter::operator++ () { add( 1 ); }
+inline void ShardedCounter::operator-- () { add( -1 ); }
+inline void ShardedCounter::operator++ ( int ) { add( 1 ); }
+inline void ShardedCounter::operator-- ( int ) { add( -1 ); }
+inline void ShardedCounter::operator+= ( int val ) { add( val ); }
+inline void ShardedCounter::operator-= ( int val ) { add( -val ); }
+
+inline int ShardedCounter::approximate () const
+{
+   int used = _numShards.value.value();
+   int sum = 0;
+   for ( int i = 0; i < used; i++ ) sum += _shards[i].value.value();
+   return sum;
+}
+
+inline int ShardedCounter::value () const
+{
+   memoryFence();
+   return approximate();
+}
+
+} // namespace nanos
+
+#endif
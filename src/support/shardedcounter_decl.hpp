@@ -0,0 +1,93 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_SHARDED_COUNTER_DECL
+#define _NANOS_SHARDED_COUNTER_DECL
+
+#include "atomic_decl.hpp"
+
+namespace nanos {
+
+   /*! \class ShardedCounter
+    *  \brief Integer counter split in per-thread shards
+    *
+    *  Each thread updates the shard selected by its thread id, and each shard lives in its own
+    *  cache line, so frequently updated global counters (e.g. the number of ready tasks) do not
+    *  make all the threads fight for the same line. Only the shards that have ever been used
+    *  are read to compute the value of the counter.
+    *
+    *  Individual shards may be negative (a thread can decrement a task that another thread
+    *  counted), only their sum is meaningful.
+    */
+   class ShardedCounter
+   {
+      public:
+         enum { MAX_SHARDS = 64, CACHE_LINE_SIZE = 64 };
+      private:
+         typedef struct {
+            Atomic<int>    value;
+            char           pad[CACHE_LINE_SIZE - sizeof(Atomic<int>)];
+         } __attribute__((aligned(CACHE_LINE_SIZE))) Shard;
+
+         Shard                   _numShards;             /**< Number of shards in use, value only grows */
+         Shard                   _shards[MAX_SHARDS];
+
+         static __thread int     _myShard;               /**< Shard used by the current thread */
+
+      private:
+         /*! \brief ShardedCounter copy constructor (private)
+          */
+         ShardedCounter ( const ShardedCounter & );
+         /*! \brief ShardedCounter copy assignment operator (private)
+          */
+         ShardedCounter & operator= ( const ShardedCounter & );
+
+         void add ( int val );
+      public:
+         /*! \brief ShardedCounter constructor
+          */
+         ShardedCounter ( int init = 0 );
+         /*! \brief ShardedCounter destructor
+          */
+         ~ShardedCounter () {}
+
+         /*! \brief Selects the shard updated by the calling thread
+          */
+         static void setThreadShard ( unsigned id );
+
+         void operator++ ();
+         void operator-- ();
+         void operator++ ( int );
+         void operator-- ( int );
+         void operator+= ( int val );
+         void operator-= ( int val );
+
+         /*! \brief Returns the sum of the shards without ordering the reads with respect to
+          *         other memory operations. Suitable for heuristics and polling loops.
+          */
+         int approximate () const;
+         /*! \brief Returns the sum of the shards after a full memory fence. The value is exact
+          *         when no thread is updating the counter concurrently (e.g. at shutdown).
+          */
+         int value () const;
+   };
+
+} // namespace nanos
+
+#endif
@@ -28,101 +28,103 @@ using namespace nanos;
 
 SimpleAllocator::SimpleAllocator( uint64_t baseAddress, std::size_t len ) : _baseAddress( baseAddress ), _remaining ( len ), _capacity( len )
 {
-   _freeChunks[ baseAddress ] = len;
+   insertFreeChunk( baseAddress, len );
 }
 
 void SimpleAllocator::init( uint64_t baseAddress, std::size_t len )
 {
    _baseAddress = baseAddress;
-   _freeChunks[ baseAddress ] = len;
+   insertFreeChunk( baseAddress, len );
    _remaining = len;
    _capacity = len;
 }
 
-void * SimpleAllocator::allocate( std::size_t size )
+void SimpleAllocator::insertFreeChunk( uint64_t address, std::size_t size )
 {
-   SegmentMap::iterator mapIter = _freeChunks.begin();
-   void * retAddr = (void *) 0;
-   ensure(size != 0, "Error, can't allocate 0 bytes.");
-
-   while( mapIter != _freeChunks.end() && mapIter->second < size )
-   {
-      mapIter++;
-   }
-   if ( mapIter != _freeChunks.end() ) {
+   _freeChunks[ address ] = size;
+   _freeChunksBySize.insert( std::make_pair( size, address ) );
+}
 
-      uint64_t targetAddr = mapIter->first;
-      std::size_t chunkSize = mapIter->second;
+void SimpleAllocator::eraseFreeChunk( SegmentMap::iterator chunk )
+{
+   _freeChunksBySize.erase( std::make_pair( chunk->second, chunk->first ) );
+   _freeChunks.erase( chunk );
+}
 
-      _freeChunks.erase( mapIter );
+void SimpleAllocator::resizeFreeChunk( SegmentMap::iterator chunk, std::size_t size )
+{
+   _freeChunksBySize.erase( std::make_pair( chunk->second, chunk->first ) );
+   chunk->second = size;
+   _freeChunksBySize.insert( std::make_pair( size, chunk->first ) );
+}
 
-      //add the chunk with the new size (previous size - requested size)
-      if (chunkSize > size)
-         _freeChunks[ targetAddr + size ] = chunkSize - size ;
-      _allocatedChunks[ targetAddr ] = size;
+void * SimpleAllocator::allocate( std::size_t size )
+{
+   ensure(size != 0, "Error, can't allocate 0 bytes.");
 
-      retAddr = ( void * ) targetAddr;
-      _remaining -= size;
-   }
-   else {
+   // Smallest free chunk of at least size bytes, the lowest one if there are several
+   SizeIndex::iterator fit = _freeChunksBySize.lower_bound( std::make_pair( size, ( uint64_t ) 0 ) );
+   if ( fit == _freeChunksBySize.end() ) {
       // Could not get a chunk of 'size' bytes
       //*myThread->_file << __FUNCTION__ << " WARNING: Allocator is full, requested " << size << " bytes, remaining " << _remaining << " bytes." << std::endl;
       //sys.printBt();
       return NULL;
    }
- //  *(myThread->_file) << "SimpleAllocator::allocate returns " << (void *) retAddr << std::endl;
 
-   return retAddr;
+   uint64_t targetAddr = fit->second;
+   std::size_t chunkSize = fit->first;
+
+   eraseFreeChunk( _freeChunks.find( targetAddr ) );
+
+   //add the chunk with the new size (previous size - requested size)
+   if (chunkSize > size)
+      insertFreeChunk( targetAddr + size, chunkSize - size );
+   _allocatedChunks[ targetAddr ] = size;
+
+   _remaining -= size;
+ //  *(myThread->_file) << "SimpleAllocator::allocate returns " << (void *) targetAddr << std::endl;
+
+   return ( void * ) targetAddr;
 }
 
 void * SimpleAllocator::allocateSizeAligned( std::size_t size )
 {
-   SegmentMap::iterator mapIter = _freeChunks.begin();
-   void * retAddr = (void *) 0;
-
    std::size_t alignedLen;
    unsigned int count = 0;
    while ( (size >> count) != 1 ) count++;
    alignedLen = (1UL<<(count));
 
-   while( mapIter != _freeChunks.end() && 
-      mapIter->second < 
-      ( ( mapIter->first & ~(alignedLen-1) ) +
-        ( ( ( mapIter->first & (alignedLen-1) ) == 0 ) ? 0 : alignedLen ) +
-        size ) -
-       mapIter->first )
-   {
-      mapIter++;
+   // Smallest free chunk that can hold size bytes once its start is aligned
+   SizeIndex::iterator fit = _freeChunksBySize.lower_bound( std::make_pair( size, ( uint64_t ) 0 ) );
+   uint64_t targetAddr = 0;
+   for ( ; fit != _freeChunksBySize.end(); fit++ ) {
+      targetAddr = ( fit->second + alignedLen - 1 ) & ~( ( uint64_t ) alignedLen - 1 );
+      if ( ( targetAddr - fit->second ) + size <= fit->first ) break;
    }
-   if ( mapIter != _freeChunks.end() ) {
-      uint64_t chunkAddr = mapIter->first;
-      std::size_t chunkSize = mapIter->second;
-      uint64_t targetAddr = ( mapIter->first & ~(alignedLen-1) ) + ( ( ( mapIter->first & (alignedLen-1) ) == 0 ) ? 0 : alignedLen ) ;
-
-      //add the chunk with the new size (previous size - requested size)
-      if (chunkSize > size) {
-         if (targetAddr == chunkAddr ) {
-            _freeChunks.erase( chunkAddr ); 
-         } else { 
-            _freeChunks[ mapIter->first ] = ( targetAddr - chunkAddr );
-         }
-         if ((chunkAddr + chunkSize) - (targetAddr + size) > 0)
-            _freeChunks[ targetAddr + size ] = (chunkAddr + chunkSize) - (targetAddr + size) ;
-      } else if ( chunkSize == size ) {
-         _freeChunks.erase( chunkAddr );
-      } else { fprintf(stderr, "Error, this does not make sense!\n"); }
-      _allocatedChunks[ targetAddr ] = size;
-
-      retAddr = ( void * ) targetAddr ;
-      _remaining -= size;
-   }
-   else {
+
+   if ( fit == _freeChunksBySize.end() ) {
       // Could not get a chunk of 'size' bytes
       *myThread->_file << sys.getNetwork()->getNodeNum() << ": WARNING: Allocator is full" << std::endl;
       return NULL;
    }
 
-   return retAddr;
+   uint64_t chunkAddr = fit->second;
+   std::size_t chunkSize = fit->first;
+   SegmentMap::iterator chunk = _freeChunks.find( chunkAddr );
+
+   //keep the unaligned head and the tail of the chunk, if any
+   if ( targetAddr == chunkAddr ) {
+      eraseFreeChunk( chunk );
+   } else {
+      resizeFreeChunk( chunk, targetAddr - chunkAddr );
+   }
+   if ( ( chunkAddr + chunkSize ) > ( targetAddr + size ) )
+      insertFreeChunk( targetAddr + size, ( chunkAddr + chunkSize ) - ( targetAddr + size ) );
+   _allocatedChunks[ targetAddr ] = size;
+
+   _remaining -= size;
+
+   return ( void * ) targetAddr;
 }
 
 std::size_t SimpleAllocator::free( void *address )
@@ -138,71 +140,42 @@ std::size_t SimpleAllocator::free( void *address )
    }
 
    size_t size = mapIter->second;
-   std::pair< SegmentMap::iterator, bool > ret;
    ensure (size != 0, "Invalid entry in _allocatedChunks, size == 0");
 
    _allocatedChunks.erase( mapIter );
 
-   if ( !_freeChunks.empty() ) {
-      mapIter = _freeChunks.lower_bound( ( uint64_t ) address );
+   uint64_t chunkAddr = ( uint64_t ) address;
+   std::size_t totalSize = size;
 
-      //case where address is the highest key, check if it can be merged with the previous chunk
-      if ( mapIter == _freeChunks.end() ) {
-         mapIter--;
-         if ( mapIter->first + mapIter->second == ( uint64_t ) address ) {
-            mapIter->second += size;
-         } else {
-            _freeChunks[ ( uint64_t ) address ] = size;
-         }
-      }
-      //address is not the highest key, check if it can be merged with the previous and next chunks
-      else if ( _freeChunks.key_comp()( ( uint64_t ) address, mapIter->first ) ) {
-         std::size_t totalSize = size;
-         bool firstMerge = false;
-
-         //check next chunk
-         if ( mapIter->first == ( ( uint64_t ) address ) + size ) {
-            totalSize += mapIter->second;
-            _freeChunks.erase( mapIter );
-            ret = _freeChunks.insert( SegmentMap::value_type( ( uint64_t ) address, totalSize ) );
-            mapIter = ret.first;
-            firstMerge = true;
-         }
+   SegmentMap::iterator next = _freeChunks.lower_bound( chunkAddr );
 
-         //check previous chunk
-         if ( _freeChunks.begin() != mapIter )
-         {
-            mapIter--;
-            if ( mapIter->first + mapIter->second == ( uint64_t ) address ) {
-               //if totalSize > size then the next chunk was merged
-               if ( totalSize > size ) {
-                  mapIter->second += totalSize;
-                  mapIter++;
-                  _freeChunks.erase( mapIter );
-               }
-               else {
-                  mapIter->second += size;
-               }
-            } else if ( !firstMerge ) {
-               _freeChunks[ ( uint64_t ) address ] = size;
-            }
-         }
-         else if ( !firstMerge ) {
-            _freeChunks[ ( uint64_t ) address ] = size;
-         }
-      }
-      //duplicate key, error
-      else {
-         *(myThread->_file) << "Duplicate entry in segment map, addr " << address << ", size " << size << ". Got entry with size " << mapIter->second << ". Remaining: "<< _remaining << std::endl;
-         printBt(*(myThread->_file));
-         printMap(*(myThread->_file));
-         return 0;
-      }
+   //duplicate key, error
+   if ( next != _freeChunks.end() && next->first == chunkAddr ) {
+      *(myThread->_file) << "Duplicate entry in segment map, addr " << address << ", size " << size << ". Got entry with size " << next->second << ". Remaining: "<< _remaining << std::endl;
+      printBt(*(myThread->_file));
+      printMap(*(myThread->_file));
+      return 0;
    }
-   else {
-      _freeChunks[ ( uint64_t ) address ] = size;
+
+   SegmentMap::iterator prev = _freeChunks.end();
+   if ( next != _freeChunks.begin() ) {
+      prev = next;
+      prev--;
    }
-  _remaining += size;
+
+   //check if it can be merged with the next chunk
+   if ( next != _freeChunks.end() && next->first == chunkAddr + size ) {
+      totalSize += next->second;
+      eraseFreeChunk( next );
+   }
+
+   //check if it can be merged with the previous chunk
+   if ( prev != _freeChunks.end() && prev->first + prev->second == chunkAddr ) {
+      resizeFreeChunk( prev, prev->second + totalSize );
+   } else {
+      insertFreeChunk( chunkAddr, totalSize );
+   }
+   _remaining += size;
 
    return size;
 }
@@ -227,6 +200,8 @@ void SimpleAllocator::printMap( std::ostream &o )
       totalFree += it->second;
    }
    o << "| total free bytes "<< (std::size_t) totalFree << std::endl;
+   o << (void *) this << " " << getNumFreeChunks() << " free chunks, largest " << getLargestFreeChunk()
+     << " bytes, fragmentation " << getFragmentation() << std::endl;
 }
 
 void SimpleAllocator::lock() {
@@ -307,6 +282,19 @@ std::size_t SimpleAllocator::getCapacity() const {
    return _capacity;
 }
 
+std::size_t SimpleAllocator::getNumFreeChunks() const {
+   return _freeChunks.size();
+}
+
+std::size_t SimpleAllocator::getLargestFreeChunk() const {
+   return _freeChunksBySize.empty() ? 0 : _freeChunksBySize.rbegin()->first;
+}
+
+double SimpleAllocator::getFragmentation() const {
+   if ( _remaining == 0 ) return 0.0;
+   return 1.0 - ( ( double ) getLargestFreeChunk() / ( double ) _remaining );
+}
+
 BufferManager::BufferManager( void * address, std::size_t size )
 {
    init(address,size);
@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <set>
 #include <list>
 #include <ostream>
 
@@ -31,20 +32,29 @@
 namespace nanos {
 
    /*! \brief Simple memory allocator to manage a given contiguous memory area
+    *
+    *  Free chunks are kept both by address, to coalesce them on free, and by size, so
+    *  allocations take the smallest chunk that fits (best-fit) in logarithmic time.
     */
    class SimpleAllocator
    {
       private:
          typedef std::map < uint64_t, std::size_t > SegmentMap;
+         typedef std::set < std::pair < std::size_t, uint64_t > > SizeIndex;
 
          SegmentMap _allocatedChunks;
          SegmentMap _freeChunks;
+         SizeIndex  _freeChunksBySize; //!< Same chunks as _freeChunks, ordered by size and then by address
 
          uint64_t _baseAddress;
          Lock     _lock;
          std::size_t _remaining;
          std::size_t _capacity;
 
+         void insertFreeChunk( uint64_t address, std::size_t size );
+         void eraseFreeChunk( SegmentMap::iterator chunk );
+         void resizeFreeChunk( SegmentMap::iterator chunk, std::size_t size );
+
       public:
          typedef std::list< std::pair< uint64_t, std::size_t > > ChunkList;
 
@@ -52,7 +62,7 @@ namespace nanos {
 
          // WARNING: Calling this constructor requires calling init() at some time
          // before any allocate() or free() methods are called
-         SimpleAllocator() : _baseAddress( 0 ), _remaining( 0 )  { }
+         SimpleAllocator() : _baseAddress( 0 ), _remaining( 0 ), _capacity( 0 ) { }
 
          void init( uint64_t baseAddress, std::size_t len );
          uint64_t getBaseAddress ();
@@ -68,6 +78,15 @@ namespace nanos {
 
          void printMap( std::ostream &o );
          std::size_t getCapacity() const;
+
+         /*! \brief Number of free chunks */
+         std::size_t getNumFreeChunks() const;
+         /*! \brief Size of the largest free chunk, the largest allocation that can succeed */
+         std::size_t getLargestFreeChunk() const;
+         /*! \brief External fragmentation: 0 when all the free memory is contiguous, close to 1
+          *  when it is split in many small chunks (1 - largest free chunk / free memory)
+          */
+         double getFragmentation() const;
          uint64_t getBasePointer( uint64_t address, size_t size );
 
    };
@@ -0,0 +1,158 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "slaballocator.hpp"
+#include "config.hpp"
+#include <iomanip>
+#include <new>
+
+using namespace nanos;
+
+size_t SlabAllocator::_headerSize = NANOS_ALIGNED_MEMORY_OFFSET( 0, sizeof(SlabAllocator::ChunkHeader), 16 );
+
+__thread SlabAllocator::Cache * SlabAllocator::_myCache = NULL;
+
+SlabAllocator::Cache::Cache ( Cache *next ) : _slabs( NULL ), _next( next )
+{
+   for ( unsigned int c = 0; c < NANOS_SLAB_NUM_CLASSES; c++ ) {
+      _free[c] = NULL;
+      _remote[c] = NULL;
+      _hits[c] = 0;
+      _misses[c] = 0;
+      _remoteFrees[c] = 0;
+   }
+}
+
+SlabAllocator::Cache::~Cache ()
+{
+   while ( _slabs != NULL ) {
+      Slab *slab = _slabs;
+      _slabs = slab->_next;
+      free( slab );
+   }
+}
+
+bool SlabAllocator::Cache::reclaimRemote ( unsigned int c )
+{
+   FreeChunk *list;
+
+   // Detach the whole remote list at once
+   do {
+      list = _remote[c];
+      if ( list == NULL ) return false;
+   } while ( !compareAndSwap( &_remote[c], list, (FreeChunk *) NULL ) );
+
+   // Local list is empty when we get here, so the remote one just replaces it
+   _free[c] = list;
+   for ( FreeChunk *chunk = list; chunk != NULL; chunk = chunk->_next ) _remoteFrees[c]++;
+
+   return true;
+}
+
+void SlabAllocator::Cache::refill ( unsigned int c )
+{
+   size_t chunkSize = getClassSize( c );
+   size_t slabHeader = NANOS_ALIGNED_MEMORY_OFFSET( 0, sizeof(Slab), 16 );
+   size_t numChunks = ( NANOS_SLAB_SIZE - slabHeader ) / chunkSize;
+
+   Slab *slab = (Slab *) malloc( slabHeader + numChunks * chunkSize );
+   if ( slab == NULL ) throw(NANOS_ENOMEM);
+   slab->_next = _slabs;
+   _slabs = slab;
+
+   // Carving the slab backwards leaves the free list in address order
+   char *base = ((char *) slab) + slabHeader;
+   for ( size_t i = numChunks; i > 0; i-- ) {
+      ChunkHeader *chunk = (ChunkHeader *) ( base + ( i - 1 ) * chunkSize );
+      chunk->_owner = this;
+      chunk->_class = c;
+      FreeChunk *object = (FreeChunk *) ( ((char *) chunk) + _headerSize );
+      object->_next = _free[c];
+      _free[c] = object;
+   }
+}
+
+SlabAllocator::SlabAllocator () : _caches( NULL ), _lock(), _bigObjects( 0 ), _enabled( true ), _printStats( false ) {}
+
+SlabAllocator::~SlabAllocator ()
+{
+   while ( _caches != NULL ) {
+      Cache *cache = _caches;
+      _caches = cache->getNext();
+      cache->~Cache();
+      free( cache );
+   }
+}
+
+void SlabAllocator::config ( Config &cfg )
+{
+   cfg.registerConfigOption( "no-wd-slab", NEW Config::FlagOption( _enabled, false ),
+                             "Disables per thread slab caches for WorkDescriptor allocation" );
+   cfg.registerArgOption( "no-wd-slab", "disable-wd-slab" );
+
+   cfg.registerConfigOption( "wd-slab-stats", NEW Config::FlagOption( _printStats ),
+                             "Prints WorkDescriptor slab caches statistics at shutdown" );
+   cfg.registerArgOption( "wd-slab-stats", "wd-slab-stats" );
+}
+
+SlabAllocator::Cache & SlabAllocator::createCache ()
+{
+   // Caches are allocated outside the NEW/delete tracking as they outlive their threads
+   Cache *cache = (Cache *) malloc( sizeof(Cache) );
+   if ( cache == NULL ) throw(NANOS_ENOMEM);
+
+   {
+      LockBlock lock( _lock );
+      new ( cache ) Cache( _caches );
+      _caches = cache;
+   }
+
+   _myCache = cache;
+   return *cache;
+}
+
+void SlabAllocator::printStats ( std::ostream &o )
+{
+   unsigned long hits[NANOS_SLAB_NUM_CLASSES], misses[NANOS_SLAB_NUM_CLASSES], remoteFrees[NANOS_SLAB_NUM_CLASSES];
+   unsigned int numCaches = 0;
+
+   for ( unsigned int c = 0; c < NANOS_SLAB_NUM_CLASSES; c++ ) hits[c] = misses[c] = remoteFrees[c] = 0;
+
+   // Counters are owned by each thread, so values may be slightly outdated
+   {
+      LockBlock lock( _lock );
+      for ( Cache *cache = _caches; cache != NULL; cache = cache->getNext() ) {
+         for ( unsigned int c = 0; c < NANOS_SLAB_NUM_CLASSES; c++ ) {
+            hits[c] += cache->getHits( c );
+            misses[c] += cache->getMisses( c );
+            remoteFrees[c] += cache->getRemoteFrees( c );
+         }
+         numCaches++;
+      }
+   }
+
+   o << "=== WorkDescriptor slab allocator (" << numCaches << " thread caches)" << std::endl;
+   o << "===  " << std::setw(10) << "class" << std::setw(14) << "hits" << std::setw(14) << "misses"
+     << std::setw(14) << "remote frees" << std::endl;
+   for ( unsigned int c = 0; c < NANOS_SLAB_NUM_CLASSES; c++ ) {
+      o << "===  " << std::setw(10) << getClassSize( c ) << std::setw(14) << hits[c] << std::setw(14) << misses[c]
+        << std::setw(14) << remoteFrees[c] << std::endl;
+   }
+   o << "=== " << _bigObjects.value() << " requests served by malloc" << std::endl;
+}
@@ -0,0 +1,146 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_SLAB_ALLOCATOR_HPP
+#define _NANOS_SLAB_ALLOCATOR_HPP
+
+#include "slaballocator_decl.hpp"
+#include "atomic.hpp"
+#include "lock.hpp"
+#include "nanos_error.h"
+#include <cstdlib>
+
+namespace nanos {
+
+inline SlabAllocator::Cache * SlabAllocator::Cache::getNext () const
+{
+   return _next;
+}
+
+inline unsigned long SlabAllocator::Cache::getHits ( unsigned int c ) const
+{
+   return _hits[c];
+}
+
+inline unsigned long SlabAllocator::Cache::getMisses ( unsigned int c ) const
+{
+   return _misses[c];
+}
+
+inline unsigned long SlabAllocator::Cache::getRemoteFrees ( unsigned int c ) const
+{
+   return _remoteFrees[c];
+}
+
+inline void * SlabAllocator::Cache::allocate ( unsigned int c )
+{
+   if ( _free[c] != NULL ) _hits[c]++;
+   else if ( reclaimRemote( c ) ) _hits[c]++;
+   else {
+      refill( c );
+      _misses[c]++;
+   }
+
+   FreeChunk *chunk = _free[c];
+   _free[c] = chunk->_next;
+
+   return (void *) chunk;
+}
+
+inline void SlabAllocator::Cache::deallocate ( ChunkHeader *chunk )
+{
+   FreeChunk *object = (FreeChunk *) ( ((char *) chunk) + _headerSize );
+   object->_next = _free[chunk->_class];
+   _free[chunk->_class] = object;
+}
+
+inline void SlabAllocator::Cache::deallocateRemote ( ChunkHeader *chunk )
+{
+   unsigned int c = chunk->_class;
+   FreeChunk *object = (FreeChunk *) ( ((char *) chunk) + _headerSize );
+   FreeChunk *head;
+
+   // Pushing is safe against ABA as the owner only detaches the whole list
+   do {
+      head = _remote[c];
+      object->_next = head;
+   } while ( !compareAndSwap( &_remote[c], head, object ) );
+}
+
+inline unsigned int SlabAllocator::getSizeClass ( size_t size )
+{
+   size_t realSize = size + _headerSize;
+   unsigned int c = 0;
+
+   while ( c < NANOS_SLAB_NUM_CLASSES && getClassSize( c ) < realSize ) c++;
+
+   return c;
+}
+
+inline size_t SlabAllocator::getClassSize ( unsigned int c )
+{
+   return ( (size_t) 1 ) << ( c + NANOS_SLAB_MIN_CHUNK_SHIFT );
+}
+
+inline SlabAllocator::Cache & SlabAllocator::getCache ()
+{
+   if ( _myCache != NULL ) return *_myCache;
+   return createCache();
+}
+
+inline void * SlabAllocator::allocateBigObject ( size_t size )
+{
+   ChunkHeader *ptr = (ChunkHeader *) malloc( size + _headerSize );
+   if ( ptr == NULL ) throw(NANOS_ENOMEM);
+   ptr->_owner = NULL;
+   _bigObjects++;
+
+   return ((char *) ptr ) + _headerSize;
+}
+
+inline void * SlabAllocator::allocate ( size_t size )
+{
+   if ( !_enabled ) return allocateBigObject( size );
+
+   unsigned int c = getSizeClass( size );
+   if ( c == NANOS_SLAB_NUM_CLASSES ) return allocateBigObject( size );
+
+   return getCache().allocate( c );
+}
+
+inline void SlabAllocator::deallocate ( void *object )
+{
+   if ( object == NULL ) return;
+
+   ChunkHeader *ptr = (ChunkHeader *) ( ((char *) object) - _headerSize );
+   Cache *owner = ptr->_owner;
+
+   if ( owner == NULL ) free( ptr );
+   else if ( owner == _myCache ) owner->deallocate( ptr );
+   else owner->deallocateRemote( ptr );
+}
+
+inline bool SlabAllocator::isPrintStatsEnabled () const
+{
+   return _printStats;
+}
+
+} // namespace nanos
+
+#endif
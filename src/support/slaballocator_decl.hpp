@@ -0,0 +1,168 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_SLAB_ALLOCATOR_DECL_HPP
+#define _NANOS_SLAB_ALLOCATOR_DECL_HPP
+
+#include "slaballocator_fwd.hpp"
+#include "allocator_decl.hpp"
+#include "lock_decl.hpp"
+#include "atomic_decl.hpp"
+#include "config_fwd.hpp"
+#include <ostream>
+
+#define NANOS_SLAB_MIN_CHUNK_SHIFT 7     /* Smallest size class is 128 bytes */
+#define NANOS_SLAB_NUM_CLASSES 8         /* Size classes from 128 bytes to 16 Kbytes */
+#define NANOS_SLAB_SIZE (64*1024)        /* Memory requested to the system on each cache refill */
+
+namespace nanos {
+
+/*! \class SlabAllocator
+ *  \brief Size-classed allocator with per-thread caches
+ *
+ *  Every thread gets its own Cache, holding one free list per size class
+ *  (power of two from 128 bytes to 16 Kbytes). Allocations are served from
+ *  the local free list of the calling thread, so the common path does not
+ *  use any lock nor atomic operation. When a chunk is released by a thread
+ *  which does not own it, the chunk is pushed in a lock-free remote list of
+ *  the owner Cache, that will be reclaimed by the owner as soon as its local
+ *  list gets empty. Requests bigger than the largest size class (or all of
+ *  them, when the allocator is disabled) are forwarded to malloc.
+ *
+ *  Caches are never destroyed while the allocator is alive, as chunks may
+ *  still be returned to them after their owner thread has finished. The
+ *  calling thread Cache is kept in thread local storage, so only one
+ *  SlabAllocator is expected per process (see System::getWDAllocator).
+ */
+class SlabAllocator
+{
+   private:
+      class Cache;
+
+      /*! \brief Header preceding every chunk
+       *
+       *  A chunk always belongs to the same Cache, so the header is written
+       *  once when the slab is carved and it is only read afterwards.
+       */
+      struct ChunkHeader {
+         Cache          *_owner;   /**< Owner Cache (NULL for chunks obtained from malloc) */
+         unsigned int    _class;   /**< Size class of the chunk */
+      };
+
+      /*! \brief Free chunks are linked through their (unused) payload */
+      struct FreeChunk {
+         FreeChunk      *_next;    /**< Next free chunk in the list */
+      };
+
+      /*! \brief Slabs obtained from the system are linked to be released at the end */
+      struct Slab {
+         Slab           *_next;    /**< Next slab of the same Cache */
+      };
+
+      /*! \class Cache
+       *  \brief Per-thread set of free lists
+       */
+      class Cache
+      {
+         private:
+            FreeChunk        *_free[NANOS_SLAB_NUM_CLASSES];         /**< Local free lists (owner thread only) */
+            Slab             *_slabs;                                /**< Slabs carved by this Cache */
+            Cache            *_next;                                 /**< Next Cache in the allocator registry */
+            unsigned long     _hits[NANOS_SLAB_NUM_CLASSES];         /**< Requests served without a refill */
+            unsigned long     _misses[NANOS_SLAB_NUM_CLASSES];       /**< Requests that needed a new slab */
+            unsigned long     _remoteFrees[NANOS_SLAB_NUM_CLASSES];  /**< Chunks reclaimed from the remote lists */
+            char              _pad[NANOS_CACHELINE];                 /**< Keeps remote lists away from owner's data */
+            FreeChunk        *_remote[NANOS_SLAB_NUM_CLASSES];       /**< Chunks released by other threads */
+
+            /*! \brief Cache copy constructor (disabled) */
+            Cache ( const Cache &c );
+            /*! \brief Cache copy assignment operator (disabled) */
+            Cache & operator= ( const Cache &c );
+
+            /*! \brief Moves the remote list of class 'c' to the local one, returns false if it was empty */
+            bool reclaimRemote ( unsigned int c );
+            /*! \brief Carves a new slab into chunks of class 'c' */
+            void refill ( unsigned int c );
+         public:
+            /*! \brief Cache constructor */
+            Cache ( Cache *next );
+            /*! \brief Cache destructor, releases all the slabs */
+            ~Cache ();
+
+            /*! \brief Returns a chunk of class 'c' */
+            void * allocate ( unsigned int c );
+            /*! \brief Returns 'chunk' to the local list (called from the owner thread) */
+            void deallocate ( ChunkHeader *chunk );
+            /*! \brief Returns 'chunk' to the remote list (called from any other thread) */
+            void deallocateRemote ( ChunkHeader *chunk );
+
+            Cache * getNext () const;
+            unsigned long getHits ( unsigned int c ) const;
+            unsigned long getMisses ( unsigned int c ) const;
+            unsigned long getRemoteFrees ( unsigned int c ) const;
+      };
+
+   private: /* SlabAllocator data members */
+      Cache                *_caches;        /**< Registry of all the Caches created so far */
+      Lock                  _lock;          /**< Protects the registry */
+      Atomic<unsigned long> _bigObjects;    /**< Requests forwarded to malloc */
+      bool                  _enabled;       /**< Use slab caches (otherwise all requests go to malloc) */
+      bool                  _printStats;    /**< Print per size class statistics at shutdown */
+      static size_t         _headerSize;    /**< Size of ChunkHeader (keeping payload alignment) */
+      static __thread Cache *_myCache;      /**< Cache of the calling thread */
+
+      /*! \brief SlabAllocator copy constructor (disabled) */
+      SlabAllocator ( const SlabAllocator &a );
+      /*! \brief SlabAllocator copy assignment operator (disabled) */
+      SlabAllocator & operator= ( const SlabAllocator &a );
+
+      /*! \brief Returns the size class for a request of 'size' bytes (NANOS_SLAB_NUM_CLASSES if too big) */
+      static unsigned int getSizeClass ( size_t size );
+      /*! \brief Returns the size of the chunks of class 'c' (header included) */
+      static size_t getClassSize ( unsigned int c );
+      /*! \brief Returns the Cache of the calling thread, creating it if needed */
+      Cache & getCache ();
+      /*! \brief Creates and registers the Cache of the calling thread */
+      Cache & createCache ();
+      /*! \brief Allocation path for requests not served by the caches */
+      void * allocateBigObject ( size_t size );
+
+   public: /* SlabAllocator method members */
+      /*! \brief SlabAllocator default constructor */
+      SlabAllocator ();
+      /*! \brief SlabAllocator destructor */
+      ~SlabAllocator ();
+
+      /*! \brief Registers the allocator configuration options */
+      void config ( Config &cfg );
+
+      /*! \brief Allocates 'size' bytes, aligned to 16 bytes */
+      void * allocate ( size_t size );
+      /*! \brief Releases 'object', which may have been allocated by any thread */
+      static void deallocate ( void *object );
+
+      /*! \brief Whether statistics have been requested by the user */
+      bool isPrintStatsEnabled () const;
+      /*! \brief Prints hits, misses and remote frees of each size class */
+      void printStats ( std::ostream &o );
+};
+
+} // namespace nanos
+
+#endif
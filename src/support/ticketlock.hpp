@@ -0,0 +1,69 @@
+/*************************************************************************************/
+/*      Copyright 2009 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_TICKET_LOCK
+#define _NANOS_TICKET_LOCK
+
+#include "atomic.hpp"
+#include "ticketlock_decl.hpp"
+
+namespace nanos {
+
+inline void TicketLock::acquire ()
+{
+   unsigned int ticket = _next.fetchAndAdd();
+
+   while ( true ) {
+      // Unsigned arithmetic keeps the distance right when tickets wrap around
+      unsigned int ahead = ticket - _serving.value();
+      if ( ahead == 0 ) return;
+      for ( unsigned int i = 0; i < ahead * BACKOFF_PER_TICKET; i++ ) cpuRelax();
+   }
+}
+
+inline bool TicketLock::tryAcquire ()
+{
+   unsigned int serving = _serving.value();
+   if ( _next.value() != serving ) return false;
+   return _next.cswap( serving, serving + 1 );
+}
+
+inline void TicketLock::release ()
+{
+   _serving.fetchAndAdd();
+}
+
+inline bool TicketLock::isLocked () const
+{
+   return _next.value() != _serving.value();
+}
+
+inline void TicketLock::operator++ ( int val )
+{
+   acquire();
+}
+
+inline void TicketLock::operator-- ( int val )
+{
+   release();
+}
+
+} // namespace nanos
+
+#endif
@@ -0,0 +1,67 @@
+/*************************************************************************************/
+/*      Copyright 2009 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#ifndef _NANOS_TICKET_LOCK_DECL
+#define _NANOS_TICKET_LOCK_DECL
+
+#include "atomic_decl.hpp"
+
+namespace nanos {
+
+   /*! \class TicketLock
+    *  \brief FIFO spin lock
+    *
+    *  Each acquirer takes a ticket and waits until it is served, so the lock is granted in
+    *  arrival order and a release only invalidates the line once. Waiters back off in
+    *  proportion to the number of tickets ahead of them.
+    */
+   class TicketLock
+   {
+      private:
+         /*! cpuRelax() calls per ticket ahead between checks */
+         enum { BACKOFF_PER_TICKET = 16 };
+
+         Atomic<unsigned int>    _next;      /**< Next ticket to hand out */
+         Atomic<unsigned int>    _serving;   /**< Ticket that holds the lock */
+
+         // disable copy constructor and assignment operator
+         TicketLock( const TicketLock &lock );
+         const TicketLock & operator= ( const TicketLock& );
+
+      public:
+         TicketLock() : _next( 0 ), _serving( 0 ) {}
+
+         ~TicketLock() {}
+
+         void acquire();
+
+         bool tryAcquire();
+
+         void release();
+
+         bool isLocked () const;
+
+         void operator++ ( int val );
+
+         void operator-- ( int val );
+   };
+
+} // namespace nanos
+
+#endif
@@ -70,9 +70,9 @@ max_cpus=int(max_cpus)
 
 scheduling_performance=[]
 scheduling_small=['--schedule=dbf','--schedule=dbf --schedule-priority']
-scheduling_large=['--schedule=bf --bf-stack','--schedule=bf --no-bf-stack','--schedule=dbf', '--schedule=affinity']
-throttle=['--throttle=dummy','--throttle=idlethreads','--throttle=numtasks','--throttle=readytasks','--throttle=taskdepth']
-barriers=['--barrier=centralized','--barrier=tree']
+scheduling_large=['--schedule=bf --bf-stack','--schedule=bf --no-bf-stack','--schedule=dbf', '--schedule=dbf --schedule-ws-deque', '--schedule=dbf --schedule-priority --schedule-priority-heap', '--schedule=affinity', '--schedule=hws']
+throttle=['--throttle=dummy','--throttle=idlethreads','--throttle=numtasks','--throttle=readytasks','--throttle=taskdepth','--throttle=footprint']
+barriers=['--barrier=centralized','--barrier=tree','--barrier=hierarchical']
 binding=['--disable-binding','--no-disable-binding']
 architecture=['--architecture=smp']
 
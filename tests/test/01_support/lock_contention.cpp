@@ -0,0 +1,115 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+/*
+<testinfo>
+compile_versions="tas ticket mcs"
+test_CXXFLAGS_tas="-DLOCK_TYPE=Lock"
+test_CXXFLAGS_ticket="-DLOCK_TYPE=TicketLock"
+test_CXXFLAGS_mcs="-DLOCK_TYPE=McsLock"
+test_generator="gens/core-generator -a \"--gpus=0\""
+</testinfo>
+*/
+
+/*
+ * Lock contention benchmark: one thread per online CPU increments a shared counter inside a
+ * short critical section. Checks mutual exclusion and reports the cost of each acquisition.
+ */
+
+#include "config.hpp"
+#include "nanos.h"
+#include "lock.hpp"
+#include "ticketlock.hpp"
+#include "mcslock.hpp"
+#include <iostream>
+#include <pthread.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define STR(x)   #x
+#define XSTR(x)  STR(x)
+
+#define MAX_THREADS     8
+#define ITERATIONS      100000
+
+using namespace nanos;
+
+typedef LOCK_TYPE TestLock;
+
+static TestLock sharedLock;
+static TestLock otherLock;
+static volatile int inside = 0;
+static long counter = 0;
+static int errors = 0;
+
+static void * contend ( void * )
+{
+   for ( int i = 0; i < ITERATIONS; i++ ) {
+      GenericLockBlock<TestLock> guard( sharedLock );
+      if ( ++inside != 1 ) errors++;
+      counter++;
+      inside--;
+   }
+   return NULL;
+}
+
+static double now ()
+{
+   struct timeval tv;
+   gettimeofday( &tv, NULL );
+   return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+int main ( int argc, char **argv )
+{
+   // Holding two locks at a time and tryAcquire
+   sharedLock.acquire();
+   if ( sharedLock.tryAcquire() ) {
+      std::cout << "Error: tryAcquire succeeded on a busy lock" << std::endl;
+      return 1;
+   }
+   otherLock++;
+   sharedLock.release();
+   otherLock--;
+   if ( !sharedLock.tryAcquire() ) {
+      std::cout << "Error: tryAcquire failed on a free lock" << std::endl;
+      return 1;
+   }
+   sharedLock.release();
+
+   int nthreads = (int) sysconf( _SC_NPROCESSORS_ONLN );
+   if ( nthreads < 1 ) nthreads = 1;
+   if ( nthreads > MAX_THREADS ) nthreads = MAX_THREADS;
+
+   pthread_t threads[MAX_THREADS];
+   double start = now();
+   for ( int t = 0; t < nthreads; t++ ) pthread_create( &threads[t], NULL, contend, NULL );
+   for ( int t = 0; t < nthreads; t++ ) pthread_join( threads[t], NULL );
+   double elapsed = now() - start;
+
+   std::cout << XSTR(LOCK_TYPE) << ": " << nthreads << " threads, "
+             << elapsed * 1e9 / ( (double) nthreads * ITERATIONS ) << " ns per acquisition" << std::endl;
+
+   if ( errors != 0 || counter != (long) nthreads * ITERATIONS ) {
+      std::cout << "Error: " << errors << " overlapping critical sections, counter " << counter
+                << " (expected " << (long) nthreads * ITERATIONS << ")" << std::endl;
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,92 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/* DESCRIPTION: Checks the chunk selection (best-fit), the coalescing on free and the
+ * fragmentation statistics of SimpleAllocator. The managed area is never accessed.
+ */
+
+/*<testinfo>
+test_generator="gens/core-generator"
+</testinfo>*/
+
+#include <iostream>
+#include "simpleallocator.hpp"
+
+using namespace nanos;
+
+#define BASE      0x10000000UL
+#define CAPACITY  ( 1024 * 1024 )
+#define NUM       64
+#define SIZE      1024
+
+int main (int argc, char **argv)
+{
+   bool check = true;
+   SimpleAllocator alloc( BASE, CAPACITY );
+   void *ptrs[NUM];
+
+   if ( alloc.getNumFreeChunks() != 1 || alloc.getLargestFreeChunk() != CAPACITY ) check = false;
+   if ( alloc.getFragmentation() != 0.0 ) check = false;
+
+   // Consecutive allocations are packed from the start of the area
+   for ( int i = 0; i < NUM; i++ ) {
+      ptrs[i] = alloc.allocate( SIZE );
+      if ( ptrs[i] != (void *) ( BASE + i * SIZE ) ) check = false;
+   }
+
+   // Freeing every other chunk leaves NUM/2 holes of SIZE bytes plus the tail
+   for ( int i = 0; i < NUM; i += 2 ) {
+      if ( alloc.free( ptrs[i] ) != SIZE ) check = false;
+   }
+   if ( alloc.getNumFreeChunks() != NUM / 2 + 1 ) check = false;
+   if ( alloc.getLargestFreeChunk() != CAPACITY - NUM * SIZE ) check = false;
+   if ( alloc.getFragmentation() <= 0.0 ) check = false;
+
+   // Best-fit: a small request goes to the lowest hole, not to the tail
+   void *small = alloc.allocate( SIZE / 2 );
+   if ( small != ptrs[0] ) check = false;
+   // A request larger than any hole goes to the tail
+   void *large = alloc.allocate( 2 * SIZE );
+   if ( large != (void *) ( BASE + NUM * SIZE ) ) check = false;
+   // An exact fit takes the next hole
+   void *exact = alloc.allocate( SIZE );
+   if ( exact != ptrs[2] ) check = false;
+
+   // Size-aligned allocations start at a multiple of the largest power of two <= size
+   void *aligned = alloc.allocateSizeAligned( 3 * SIZE );
+   if ( aligned == NULL || ( (uint64_t) aligned & ( 2 * SIZE - 1 ) ) != 0 ) check = false;
+
+   alloc.free( small );
+   alloc.free( large );
+   alloc.free( exact );
+   alloc.free( aligned );
+   for ( int i = 1; i < NUM; i += 2 ) alloc.free( ptrs[i] );
+
+   // Everything must have been coalesced back into a single chunk
+   if ( alloc.getNumFreeChunks() != 1 || alloc.getLargestFreeChunk() != CAPACITY ) check = false;
+   if ( alloc.getFragmentation() != 0.0 ) check = false;
+
+   // The whole area can be allocated again
+   if ( alloc.allocate( CAPACITY ) != (void *) BASE ) check = false;
+   if ( alloc.allocate( 1 ) != NULL ) check = false;
+
+   if ( !check ) alloc.printMap( std::cerr );
+
+   if (check) { return 0; } else { return -1; }
+}
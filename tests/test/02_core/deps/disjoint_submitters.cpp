@@ -0,0 +1,138 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+<testinfo>
+test_generator=gens/core-generator
+</testinfo>
+*/
+
+/*
+ * Several creator tasks concurrently submit children with disjoint
+ * dependencies into the same (parent) dependencies domain. Each address is
+ * accessed twice so the domain has to chain the second task after the first
+ * one. Reports the time spent in the submission phase.
+ */
+
+#include "config.hpp"
+#include <iostream>
+#include "smpprocessor.hpp"
+#include "system.hpp"
+#include <sys/time.h>
+
+using namespace std;
+
+using namespace nanos;
+using namespace nanos::ext;
+
+#define NUM_CREATORS       8
+#define TASKS_PER_CREATOR  500
+#define ACCESSES_PER_ADDR  2
+
+int A[NUM_CREATORS][TASKS_PER_CREATOR];
+
+typedef struct {
+   int *addr;
+   int expected;
+} child_args;
+
+child_args CARGS[NUM_CREATORS][TASKS_PER_CREATOR][ACCESSES_PER_ADDR];
+
+typedef struct {
+   int id;
+   WD *parent;
+} creator_args;
+
+bool check = true;
+
+void child ( void *args );
+void child ( void *args )
+{
+   child_args *cargs = ( child_args * ) args;
+   // dependencies on the same address must be honoured in submission order
+   if ( *(cargs->addr) != cargs->expected ) check = false;
+   (*(cargs->addr))++;
+}
+
+void creator ( void *args );
+void creator ( void *args )
+{
+   creator_args *cargs = ( creator_args * ) args;
+   WD *parent = cargs->parent;
+
+   for ( int j = 0; j < ACCESSES_PER_ADDR; j++ ) {
+      for ( int i = 0; i < TASKS_PER_CREATOR; i++ ) {
+         child_args *data = &CARGS[cargs->id][i][j];
+         data->addr = &A[cargs->id][i];
+         data->expected = j;
+
+         WD * wd = new WD( new SMPDD( child ), sizeof( child_args ), __alignof__( child_args ), data );
+
+         nanos_region_dimension_internal_t dim = { sizeof( int ), 0, sizeof( int ) };
+         DataAccess dep( data->addr, true, true, false, false, false, 1, &dim, 0 );
+
+         parent->addWork( *wd );
+         parent->submitWithDependencies( *wd, 1, &dep );
+      }
+   }
+}
+
+int main ( int argc, char **argv )
+{
+   int ncreators = NUM_CREATORS;
+
+   for ( int c = 0; c < ncreators; c++ )
+      for ( int i = 0; i < TASKS_PER_CREATOR; i++ ) A[c][i] = 0;
+
+   WD *wg = getMyThreadSafe()->getCurrentWD();
+
+   creator_args cargs[NUM_CREATORS];
+
+   struct timeval start, stop;
+   gettimeofday( &start, NULL );
+
+   for ( int c = 0; c < ncreators; c++ ) {
+      cargs[c].id = c;
+      cargs[c].parent = wg;
+
+      WD * wd = new WD( new SMPDD( creator ), sizeof( creator_args ), __alignof__( creator_args ), &cargs[c] );
+      wg->addWork( *wd );
+      sys.submit( *wd );
+   }
+
+   wg->waitCompletion();
+
+   gettimeofday( &stop, NULL );
+
+   double usecs = ( stop.tv_sec - start.tv_sec ) * 1.0e6 + ( stop.tv_usec - start.tv_usec );
+   cout << ncreators << " creators, " << ncreators * TASKS_PER_CREATOR * ACCESSES_PER_ADDR
+        << " tasks: " << usecs << " us" << endl;
+
+   for ( int c = 0; c < ncreators; c++ )
+      for ( int i = 0; i < TASKS_PER_CREATOR; i++ ) if ( A[c][i] != ACCESSES_PER_ADDR ) check = false;
+
+   if ( check ) {
+      fprintf(stderr, "%s : %s\n", argv[0], "successful");
+      return 0;
+   }
+   else {
+      fprintf(stderr, "%s: %s\n", argv[0], "unsuccessful");
+      return -1;
+   }
+}
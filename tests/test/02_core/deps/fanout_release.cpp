@@ -0,0 +1,118 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+<testinfo>
+test_generator=gens/core-generator
+</testinfo>
+*/
+
+/*
+ * One producer releases a large number of readers at once when it finishes,
+ * which exercises the batch release of successors. A last writer waits for
+ * all of them. Reports the elapsed time.
+ */
+
+#include "config.hpp"
+#include <iostream>
+#include "smpprocessor.hpp"
+#include "system.hpp"
+#include <sys/time.h>
+
+using namespace std;
+
+using namespace nanos;
+using namespace nanos::ext;
+
+#define NUM_READERS  300
+#define NUM_ROUNDS   10
+
+int X;
+Atomic<int> readCount;
+
+bool check = true;
+
+typedef struct {
+   int round;
+} task_args;
+
+void producer ( void *args );
+void producer ( void *args )
+{
+   task_args *targs = ( task_args * ) args;
+   if ( X != targs->round || readCount.value() != targs->round * NUM_READERS ) check = false;
+   X = targs->round + 1;
+}
+
+void reader ( void *args );
+void reader ( void *args )
+{
+   task_args *targs = ( task_args * ) args;
+   // every reader must run after the producer of its round
+   if ( X != targs->round + 1 ) check = false;
+   readCount++;
+}
+
+int main ( int argc, char **argv )
+{
+   X = 0;
+   readCount = 0;
+
+   WD *wg = getMyThreadSafe()->getCurrentWD();
+
+   task_args args[NUM_ROUNDS];
+   nanos_region_dimension_internal_t dim = { sizeof( int ), 0, sizeof( int ) };
+
+   struct timeval start, stop;
+   gettimeofday( &start, NULL );
+
+   for ( int r = 0; r < NUM_ROUNDS; r++ ) {
+      args[r].round = r;
+
+      WD * wd = new WD( new SMPDD( producer ), sizeof( task_args ), __alignof__( task_args ), &args[r] );
+      DataAccess dep_out( &X, true, true, false, false, false, 1, &dim, 0 );
+      wg->addWork( *wd );
+      wg->submitWithDependencies( *wd, 1, &dep_out );
+
+      for ( int i = 0; i < NUM_READERS; i++ ) {
+         WD * rwd = new WD( new SMPDD( reader ), sizeof( task_args ), __alignof__( task_args ), &args[r] );
+         DataAccess dep_in( &X, true, false, false, false, false, 1, &dim, 0 );
+         wg->addWork( *rwd );
+         wg->submitWithDependencies( *rwd, 1, &dep_in );
+      }
+   }
+
+   wg->waitCompletion();
+
+   gettimeofday( &stop, NULL );
+
+   double usecs = ( stop.tv_sec - start.tv_sec ) * 1.0e6 + ( stop.tv_usec - start.tv_usec );
+   cout << NUM_ROUNDS << " rounds of " << NUM_READERS << " readers: " << usecs << " us" << endl;
+
+   if ( X != NUM_ROUNDS || readCount.value() != NUM_ROUNDS * NUM_READERS ) check = false;
+
+   if ( check ) {
+      fprintf(stderr, "%s : %s\n", argv[0], "successful");
+      return 0;
+   }
+   else {
+      fprintf(stderr, "%s: %s\n", argv[0], "unsuccessful");
+      return -1;
+   }
+}
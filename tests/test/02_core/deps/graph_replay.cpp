@@ -0,0 +1,153 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+<testinfo>
+test_generator=gens/core-generator
+</testinfo>
+*/
+
+/*
+ * Captures one iteration of a blocked update + accumulation graph and replays
+ * it for the following iterations, changing only the iteration number in the
+ * task arguments. Every task checks that it runs after its predecessors.
+ */
+
+#include "config.hpp"
+#include "nanos.h"
+#include <iostream>
+#include "smpprocessor.hpp"
+#include "system.hpp"
+
+using namespace std;
+
+using namespace nanos;
+using namespace nanos::ext;
+
+#define NUM_BLOCKS   64
+#define NUM_ITERS    20
+
+int A[NUM_BLOCKS];
+int scaled[NUM_BLOCKS];
+int S;
+int accumulated;
+
+bool check = true;
+
+typedef struct {
+   int block;
+   int iter;
+} task_args;
+
+void scale ( void *args );
+void scale ( void *args )
+{
+   task_args *targs = ( task_args * ) args;
+   if ( scaled[targs->block] != targs->iter ) check = false;
+   A[targs->block] += targs->iter + 1;
+   scaled[targs->block] = targs->iter + 1;
+}
+
+void accumulate ( void *args );
+void accumulate ( void *args )
+{
+   task_args *targs = ( task_args * ) args;
+   // must run after the scale of its block and after the previous accumulation
+   if ( scaled[targs->block] != targs->iter + 1 ) check = false;
+   if ( accumulated != targs->iter * NUM_BLOCKS + targs->block ) check = false;
+   S += A[targs->block];
+   accumulated++;
+}
+
+void set_iteration ( unsigned int node, void *data, void *arg );
+void set_iteration ( unsigned int node, void *data, void *arg )
+{
+   ( ( task_args * ) data )->iter = *( int * ) arg;
+}
+
+int main ( int argc, char **argv )
+{
+   int expectedA[NUM_BLOCKS];
+   int expectedS = 0;
+
+   for ( int b = 0; b < NUM_BLOCKS; b++ ) {
+      A[b] = expectedA[b] = b;
+      scaled[b] = 0;
+   }
+   S = 0;
+   accumulated = 0;
+
+   for ( int it = 0; it < NUM_ITERS; it++ ) {
+      for ( int b = 0; b < NUM_BLOCKS; b++ ) {
+         expectedA[b] += it + 1;
+         expectedS += expectedA[b];
+      }
+   }
+
+   WD *wg = getMyThreadSafe()->getCurrentWD();
+
+   task_args args[NUM_BLOCKS];
+   nanos_region_dimension_internal_t dim = { sizeof( int ), 0, sizeof( int ) };
+
+   if ( nanos_graph_capture_begin() != NANOS_OK ) check = false;
+
+   for ( int b = 0; b < NUM_BLOCKS; b++ ) {
+      args[b].block = b;
+      args[b].iter = 0;
+
+      WD * swd = new WD( new SMPDD( scale ), sizeof( task_args ), __alignof__( task_args ), &args[b] );
+      DataAccess dep_a( &A[b], true, true, false, false, false, 1, &dim, 0 );
+      wg->addWork( *swd );
+      wg->submitWithDependencies( *swd, 1, &dep_a );
+
+      WD * awd = new WD( new SMPDD( accumulate ), sizeof( task_args ), __alignof__( task_args ), &args[b] );
+      DataAccess dep_acc[2] = {
+         DataAccess( &A[b], true, false, false, false, false, 1, &dim, 0 ),
+         DataAccess( &S, true, true, false, false, false, 1, &dim, 0 )
+      };
+      wg->addWork( *awd );
+      wg->submitWithDependencies( *awd, 2, dep_acc );
+   }
+
+   nanos_graph_t graph;
+   if ( nanos_graph_capture_end( &graph ) != NANOS_OK ) check = false;
+
+   wg->waitCompletion();
+
+   for ( int it = 1; it < NUM_ITERS; it++ ) {
+      if ( nanos_graph_replay( graph, set_iteration, &it ) != NANOS_OK ) check = false;
+      wg->waitCompletion();
+   }
+
+   nanos_graph_destroy( graph );
+
+   for ( int b = 0; b < NUM_BLOCKS; b++ ) {
+      if ( A[b] != expectedA[b] ) check = false;
+   }
+   if ( S != expectedS || accumulated != NUM_ITERS * NUM_BLOCKS ) check = false;
+
+   if ( check ) {
+      fprintf(stderr, "%s : %s\n", argv[0], "successful");
+      return 0;
+   }
+   else {
+      fprintf(stderr, "%s: %s\n", argv[0], "unsuccessful");
+      return -1;
+   }
+}
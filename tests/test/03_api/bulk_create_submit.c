@@ -0,0 +1,117 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+<testinfo>
+test_generator=gens/api-generator
+</testinfo>
+*/
+
+/*
+ * Loop generating its tasks in batches with nanos_create_wds_compact and
+ * nanos_submit_wds. Checks that every iteration is executed exactly once, both
+ * for mandatory tasks and for tasks the throttle policy may refuse to create.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <nanos.h>
+
+#define N        20000
+#define BATCH    256
+
+static int counts[N];
+
+typedef struct {
+   int lower;
+   int upper;
+} range_args_t;
+
+static void range_update ( range_args_t *args )
+{
+   int i;
+   for ( i = args->lower; i < args->upper; i++ ) counts[i]++;
+}
+
+typedef struct {
+   nanos_const_wd_definition_t base;
+   nanos_device_t devices[1];
+} range_wd_def_t;
+
+static nanos_smp_args_t range_update_smp_args = { (void (*)(void *)) range_update };
+static range_wd_def_t mandatory_def = {
+   { { .mandatory_creation = 1, .tied = 0 }, __alignof__(range_args_t), 0, 1, 0, "range_update" },
+   { NANOS_SMP_DESC( range_update_smp_args ) }
+};
+static range_wd_def_t optional_def = {
+   { { .mandatory_creation = 0, .tied = 0 }, __alignof__(range_args_t), 0, 1, 0, "range_update" },
+   { NANOS_SMP_DESC( range_update_smp_args ) }
+};
+
+static void bulk_loop ( range_wd_def_t *def, int step )
+{
+   nanos_wd_t wds[BATCH];
+   void *data[BATCH];
+   nanos_wd_dyn_props_t dyn_props;
+   int i, b, num_wds;
+
+   memset( &dyn_props, 0, sizeof( dyn_props ) );
+
+   for ( i = 0; i < N; i += num_wds * step ) {
+      num_wds = ( N - i + step - 1 ) / step;
+      if ( num_wds > BATCH ) num_wds = BATCH;
+
+      NANOS_SAFE( nanos_create_wds_compact( num_wds, wds, &def->base, &dyn_props, sizeof( range_args_t ),
+                                            data, nanos_current_wd(), NULL, NULL ) );
+
+      for ( b = 0; b < num_wds; b++ ) {
+         range_args_t args;
+         args.lower = i + b * step;
+         args.upper = args.lower + step < N ? args.lower + step : N;
+
+         if ( wds[b] == NULL ) range_update( &args );
+         else *( range_args_t * ) data[b] = args;
+      }
+
+      if ( wds[0] != NULL ) NANOS_SAFE( nanos_submit_wds( num_wds, wds ) );
+   }
+
+   NANOS_SAFE( nanos_wg_wait_completion( nanos_current_wd(), false ) );
+}
+
+int main ( int argc, char **argv )
+{
+   int i, errors = 0;
+
+   memset( counts, 0, sizeof( counts ) );
+
+   bulk_loop( &mandatory_def, 1 );
+   bulk_loop( &mandatory_def, 7 );
+   bulk_loop( &optional_def, 3 );
+
+   for ( i = 0; i < N; i++ )
+      if ( counts[i] != 3 ) errors++;
+
+   if ( errors != 0 ) {
+      fprintf( stderr, "%d iterations were not executed 3 times\n", errors );
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,126 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+<testinfo>
+test_generator="gens/api-omp-generator -a --omp-task-aware-locks|--omp-task-aware-locks,--omp-lock-spins=1"
+</testinfo>
+*/
+
+/*
+ * Many tasks contending for a plain and a nestable OpenMP lock in task aware mode. With a
+ * single spin most acquisitions block the task, checks that the lock is handed off to the
+ * blocked tasks without losing updates.
+ */
+
+#include <stdio.h>
+#include <nanos.h>
+#include <omp.h>
+
+#define NUM_TASKS    2000
+#define WORK         200
+
+static omp_lock_t lock;
+static omp_nest_lock_t nlock;
+static volatile int inside = 0;
+static int count = 0;
+static int ncount = 0;
+static int errors = 0;
+
+static void critical_work ( void )
+{
+   int i;
+
+   if ( ++inside != 1 ) errors++;
+   for ( i = 0; i < WORK; i++ ) count++;
+   inside--;
+}
+
+static void lock_task ( void *args )
+{
+   omp_set_lock( &lock );
+   critical_work();
+   omp_unset_lock( &lock );
+
+   while ( !omp_test_lock( &lock ) ) {}
+   critical_work();
+   omp_unset_lock( &lock );
+}
+
+static void nest_lock_task ( void *args )
+{
+   omp_set_nest_lock( &nlock );
+   omp_set_nest_lock( &nlock );
+   ncount++;
+   omp_unset_nest_lock( &nlock );
+   ncount++;
+   omp_unset_nest_lock( &nlock );
+}
+
+typedef struct {
+   nanos_const_wd_definition_t base;
+   nanos_device_t devices[1];
+} wd_def_t;
+
+static nanos_smp_args_t lock_task_args = { lock_task };
+static nanos_smp_args_t nest_lock_task_args = { nest_lock_task };
+
+static wd_def_t lock_task_def = {
+   { { .mandatory_creation = 1, .tied = 0 }, 1, 0, 1, 0, "lock_task" },
+   { { nanos_smp_factory, &lock_task_args } }
+};
+
+static wd_def_t nest_lock_task_def = {
+   { { .mandatory_creation = 1, .tied = 0 }, 1, 0, 1, 0, "nest_lock_task" },
+   { { nanos_smp_factory, &nest_lock_task_args } }
+};
+
+int main ( int argc, char **argv )
+{
+   int i;
+   nanos_wd_dyn_props_t dyn_props = { 0 };
+
+   omp_init_lock( &lock );
+   omp_init_nest_lock( &nlock );
+
+   for ( i = 0; i < NUM_TASKS; i++ ) {
+      nanos_wd_t wd = NULL;
+      NANOS_SAFE( nanos_create_wd_compact( &wd, &lock_task_def.base, &dyn_props, 0, NULL,
+                                           nanos_current_wd(), NULL, NULL ) );
+      NANOS_SAFE( nanos_submit( wd, 0, NULL, NULL ) );
+
+      wd = NULL;
+      NANOS_SAFE( nanos_create_wd_compact( &wd, &nest_lock_task_def.base, &dyn_props, 0, NULL,
+                                           nanos_current_wd(), NULL, NULL ) );
+      NANOS_SAFE( nanos_submit( wd, 0, NULL, NULL ) );
+   }
+
+   NANOS_SAFE( nanos_wg_wait_completion( nanos_current_wd(), false ) );
+
+   omp_destroy_nest_lock( &nlock );
+   omp_destroy_lock( &lock );
+
+   if ( errors != 0 || count != 2 * NUM_TASKS * WORK || ncount != 2 * NUM_TASKS ) {
+      fprintf( stderr, "errors=%d count=%d (expected %d) ncount=%d (expected %d)\n",
+               errors, count, 2 * NUM_TASKS * WORK, ncount, 2 * NUM_TASKS );
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,136 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+<testinfo>
+test_generator="gens/api-generator -a --prefetch-data=0|--prefetch-data=65536|--prefetch-data=100"
+</testinfo>
+*/
+
+/*
+ * Chains of tasks updating 2D blocks of a matrix, each task declaring its block
+ * as a copy. Checks that prefetching the copies of the next task of a thread
+ * (including partial prefetches cut by the byte budget) does not change results.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <nanos.h>
+
+#define N        256
+#define BS       64
+#define NB       ( N / BS )
+#define STEPS    8
+
+static int matrix[N][N];
+
+typedef struct {
+   int bi;
+   int bj;
+} block_args_t;
+
+static void block_update ( block_args_t *args )
+{
+   int i, j;
+   for ( i = args->bi * BS; i < ( args->bi + 1 ) * BS; i++ )
+      for ( j = args->bj * BS; j < ( args->bj + 1 ) * BS; j++ )
+         matrix[i][j]++;
+}
+
+typedef struct {
+   nanos_const_wd_definition_t base;
+   nanos_device_t devices[1];
+} block_wd_def_t;
+
+static nanos_smp_args_t block_update_smp_args = { (void (*)(void *)) block_update };
+static block_wd_def_t block_update_def = {
+   { { .mandatory_creation = 1, .tied = 0 }, __alignof__(block_args_t), 1, 1, 2, "block_update" },
+   { NANOS_SMP_DESC( block_update_smp_args ) }
+};
+
+static void submit_block_update ( int bi, int bj )
+{
+   nanos_wd_t wd = NULL;
+   block_args_t *args = NULL;
+   nanos_copy_data_t *copies = NULL;
+   nanos_region_dimension_internal_t *copy_dims = NULL;
+   nanos_region_dimension_internal_t dep_dims[1];
+   nanos_data_access_t deps[1];
+   nanos_wd_dyn_props_t dyn_props;
+
+   memset( &dyn_props, 0, sizeof( dyn_props ) );
+   NANOS_SAFE( nanos_create_wd_compact( &wd, &block_update_def.base, &dyn_props, sizeof( block_args_t ),
+                                        (void **) &args, nanos_current_wd(), &copies, &copy_dims ) );
+   args->bi = bi;
+   args->bj = bj;
+
+   /* Dimension 0 (columns) is expressed in bytes */
+   copy_dims[0].size = N * sizeof( int );
+   copy_dims[0].lower_bound = bj * BS * sizeof( int );
+   copy_dims[0].accessed_length = BS * sizeof( int );
+   copy_dims[1].size = N;
+   copy_dims[1].lower_bound = bi * BS;
+   copy_dims[1].accessed_length = BS;
+
+   copies[0].address = matrix;
+   copies[0].sharing = NANOS_SHARED;
+   copies[0].flags.input = true;
+   copies[0].flags.output = true;
+   copies[0].dimension_count = 2;
+   copies[0].dimensions = copy_dims;
+   copies[0].offset = 0;
+
+   /* Chain the updates of a block through its first element */
+   dep_dims[0].size = sizeof( int );
+   dep_dims[0].lower_bound = 0;
+   dep_dims[0].accessed_length = sizeof( int );
+   memset( deps, 0, sizeof( deps ) );
+   deps[0].address = &matrix[bi * BS][bj * BS];
+   deps[0].flags.input = true;
+   deps[0].flags.output = true;
+   deps[0].dimension_count = 1;
+   deps[0].dimensions = dep_dims;
+
+   NANOS_SAFE( nanos_submit( wd, 1, deps, NULL ) );
+}
+
+int main ( int argc, char **argv )
+{
+   int i, j, step, errors = 0;
+
+   memset( matrix, 0, sizeof( matrix ) );
+
+   for ( step = 0; step < STEPS; step++ )
+      for ( i = 0; i < NB; i++ )
+         for ( j = 0; j < NB; j++ )
+            submit_block_update( i, j );
+
+   NANOS_SAFE( nanos_wg_wait_completion( nanos_current_wd(), false ) );
+
+   for ( i = 0; i < N; i++ )
+      for ( j = 0; j < N; j++ )
+         if ( matrix[i][j] != STEPS ) errors++;
+
+   if ( errors != 0 ) {
+      fprintf( stderr, "%d elements were not updated %d times\n", errors, STEPS );
+      return 1;
+   }
+
+   return 0;
+}
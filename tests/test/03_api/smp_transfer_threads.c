@@ -0,0 +1,124 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+<testinfo>
+test_generator="gens/api-generator -a --smp-private-memory|--smp-private-memory,--smp-transfer-threads=2|--smp-private-memory,--smp-transfer-threads=2,--smp-transfer-max-bytes=16384|--smp-private-memory,--smp-transfer-max-bytes=16384"
+</testinfo>
+*/
+
+/*
+ * Chains of tasks updating the blocks of an array through their private copies. Checks that
+ * moving the copies with dedicated transfer threads, and bounding the bytes in flight, does
+ * not change results.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <nanos.h>
+
+#define N        ( 64 * 1024 )
+#define BS       4096
+#define NB       ( N / BS )
+#define STEPS    8
+
+static int array[N];
+
+typedef struct {
+   int bi;
+} block_args_t;
+
+static void block_update ( block_args_t *args )
+{
+   int i, *block = NULL;
+
+   NANOS_SAFE( nanos_get_addr( 0, (void **) &block, nanos_current_wd() ) );
+   for ( i = 0; i < BS; i++ )
+      block[i] += args->bi + 1;
+}
+
+typedef struct {
+   nanos_const_wd_definition_t base;
+   nanos_device_t devices[1];
+} block_wd_def_t;
+
+static nanos_smp_args_t block_update_smp_args = { (void (*)(void *)) block_update };
+static block_wd_def_t block_update_def = {
+   { { .mandatory_creation = 1, .tied = 0 }, __alignof__(block_args_t), 1, 1, 1, "block_update" },
+   { NANOS_SMP_DESC( block_update_smp_args ) }
+};
+
+static void submit_block_update ( int bi )
+{
+   nanos_wd_t wd = NULL;
+   block_args_t *args = NULL;
+   nanos_copy_data_t *copies = NULL;
+   nanos_region_dimension_internal_t *copy_dims = NULL;
+   nanos_data_access_t deps[1];
+   nanos_wd_dyn_props_t dyn_props;
+
+   memset( &dyn_props, 0, sizeof( dyn_props ) );
+   NANOS_SAFE( nanos_create_wd_compact( &wd, &block_update_def.base, &dyn_props, sizeof( block_args_t ),
+                                        (void **) &args, nanos_current_wd(), &copies, &copy_dims ) );
+   args->bi = bi;
+
+   copy_dims[0].size = BS * sizeof( int );
+   copy_dims[0].lower_bound = 0;
+   copy_dims[0].accessed_length = BS * sizeof( int );
+
+   copies[0].address = &array[bi * BS];
+   copies[0].sharing = NANOS_SHARED;
+   copies[0].flags.input = true;
+   copies[0].flags.output = true;
+   copies[0].dimension_count = 1;
+   copies[0].dimensions = copy_dims;
+   copies[0].offset = 0;
+
+   memset( deps, 0, sizeof( deps ) );
+   deps[0].address = &array[bi * BS];
+   deps[0].flags.input = true;
+   deps[0].flags.output = true;
+   deps[0].dimension_count = 1;
+   deps[0].dimensions = copy_dims;
+
+   NANOS_SAFE( nanos_submit( wd, 1, deps, NULL ) );
+}
+
+int main ( int argc, char **argv )
+{
+   int i, step, errors = 0;
+
+   memset( array, 0, sizeof( array ) );
+
+   for ( step = 0; step < STEPS; step++ )
+      for ( i = 0; i < NB; i++ )
+         submit_block_update( i );
+
+   NANOS_SAFE( nanos_wg_wait_completion( nanos_current_wd(), false ) );
+
+   for ( i = 0; i < N; i++ )
+      if ( array[i] != STEPS * ( i / BS + 1 ) ) errors++;
+
+   if ( errors != 0 ) {
+      fprintf( stderr, "%d elements have a wrong value\n", errors );
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,101 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+<testinfo>
+test_generator="gens/api-generator -a --smp-stack-pool=0|--smp-stack-pool=4,--smp-stack-pool-trim=1|--smp-stack-pool=1024,--smp-stack-pool-trim=0"
+</testinfo>
+*/
+
+/*
+ * A tree of untied tasks where every inner task waits for its children, so that many
+ * tasks are blocked on their own stacks at the same time. Leaves use a good part of their
+ * stack. Checks that pooled, trimmed and unmapped stacks all give the right result.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <nanos.h>
+
+#define DEPTH        10
+#define LEAF_BYTES   ( 32 * 1024 )
+
+static int leaves = 0;
+
+typedef struct {
+   int depth;
+} node_args_t;
+
+static void node ( node_args_t *args );
+
+typedef struct {
+   nanos_const_wd_definition_t base;
+   nanos_device_t devices[1];
+} node_wd_def_t;
+
+static nanos_smp_args_t node_smp_args = { (void (*)(void *)) node };
+static node_wd_def_t node_def = {
+   { { .mandatory_creation = 1, .tied = 0 }, __alignof__(node_args_t), 0, 1, 0, "node" },
+   { NANOS_SMP_DESC( node_smp_args ) }
+};
+
+static void spawn ( int depth )
+{
+   nanos_wd_t wd = NULL;
+   node_args_t *args = NULL;
+   nanos_wd_dyn_props_t dyn_props;
+
+   memset( &dyn_props, 0, sizeof( dyn_props ) );
+   NANOS_SAFE( nanos_create_wd_compact( &wd, &node_def.base, &dyn_props, sizeof( node_args_t ),
+                                        (void **) &args, nanos_current_wd(), NULL, NULL ) );
+   args->depth = depth;
+   NANOS_SAFE( nanos_submit( wd, 0, NULL, NULL ) );
+}
+
+static void node ( node_args_t *args )
+{
+   if ( args->depth == 0 ) {
+      volatile signed char buffer[LEAF_BYTES];
+      int i, sum = 0;
+
+      for ( i = 0; i < LEAF_BYTES; i++ ) buffer[i] = (signed char) i;
+      for ( i = 0; i < LEAF_BYTES; i++ ) sum += buffer[i];
+
+      if ( sum == ( LEAF_BYTES / 256 ) * -128 ) __sync_fetch_and_add( &leaves, 1 );
+      return;
+   }
+
+   spawn( args->depth - 1 );
+   spawn( args->depth - 1 );
+
+   NANOS_SAFE( nanos_wg_wait_completion( nanos_current_wd(), false ) );
+}
+
+int main ( int argc, char **argv )
+{
+   spawn( DEPTH );
+   NANOS_SAFE( nanos_wg_wait_completion( nanos_current_wd(), false ) );
+
+   if ( leaves != 1 << DEPTH ) {
+      fprintf( stderr, "%d leaves completed, expected %d\n", leaves, 1 << DEPTH );
+      return 1;
+   }
+
+   return 0;
+}
@@ -0,0 +1,110 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+
+/*
+<testinfo>
+test_generator="gens/api-generator -a --versioning-profile=versioning_profile.nxp,--versioning-min-trials=3"
+test_generator_ENV=( "NX_TEST_SCHEDULE=versioning" )
+</testinfo>
+*/
+
+/*
+ * Runs a task type with a slow and a fast version under the versioning policy, which saves
+ * the times of each version to a profile at shutdown. The first execution of the test writes
+ * the profile and the next ones start from it, so they must not explore the slow version from
+ * scratch (MIN_TRIALS executions) again.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <nanos.h>
+
+#define NUM_TASKS    200
+#define SLOW_ITERS   2000000
+#define MIN_TRIALS   3
+
+static int slow_runs = 0;
+static int fast_runs = 0;
+static int total = 0;
+
+typedef struct {
+   int value;
+} task_args_t;
+
+static void task_slow ( task_args_t *args )
+{
+   volatile int i, dummy = 0;
+   for ( i = 0; i < SLOW_ITERS; i++ ) dummy += i;
+
+   __sync_fetch_and_add( &slow_runs, 1 );
+   __sync_fetch_and_add( &total, args->value );
+}
+
+static void task_fast ( task_args_t *args )
+{
+   __sync_fetch_and_add( &fast_runs, 1 );
+   __sync_fetch_and_add( &total, args->value );
+}
+
+typedef struct {
+   nanos_const_wd_definition_t base;
+   nanos_device_t devices[2];
+} task_wd_def_t;
+
+static nanos_smp_args_t task_slow_args = { (void (*)(void *)) task_slow };
+static nanos_smp_args_t task_fast_args = { (void (*)(void *)) task_fast };
+static task_wd_def_t task_def = {
+   { { .mandatory_creation = 1, .tied = 0 }, __alignof__(task_args_t), 0, 2, 0, "versioning_profile_task" },
+   { NANOS_SMP_DESC( task_slow_args ), NANOS_SMP_DESC( task_fast_args ) }
+};
+
+int main ( int argc, char **argv )
+{
+   int i;
+   /* The runtime has already loaded the profile, if any */
+   int profiled = ( access( "versioning_profile.nxp", R_OK ) == 0 );
+
+   for ( i = 0; i < NUM_TASKS; i++ ) {
+      nanos_wd_t wd = NULL;
+      task_args_t *args = NULL;
+      nanos_wd_dyn_props_t dyn_props = { 0 };
+
+      NANOS_SAFE( nanos_create_wd_compact( &wd, &task_def.base, &dyn_props, sizeof( task_args_t ),
+                                           (void **) &args, nanos_current_wd(), NULL, NULL ) );
+      args->value = i;
+      NANOS_SAFE( nanos_submit( wd, 0, NULL, NULL ) );
+   }
+
+   NANOS_SAFE( nanos_wg_wait_completion( nanos_current_wd(), false ) );
+
+   fprintf( stderr, "%s: %d slow, %d fast executions\n", profiled ? "profiled" : "not profiled", slow_runs, fast_runs );
+
+   if ( slow_runs + fast_runs != NUM_TASKS || total != NUM_TASKS * ( NUM_TASKS - 1 ) / 2 ) {
+      fprintf( stderr, "Wrong number of executions\n" );
+      return 1;
+   }
+
+   if ( profiled && slow_runs >= MIN_TRIALS ) {
+      fprintf( stderr, "The slow version was explored again despite the saved profile\n" );
+      return 1;
+   }
+
+   return 0;
+}
@@ -19,7 +19,7 @@
 
 /*
 <testinfo>
-test_generator="gens/core-generator -a \"--gpus=0\""
+test_generator="gens/core-generator -a --gpus=0,--barrier=centralized|--barrier=hierarchical"
 </testinfo>
 */
 
@@ -0,0 +1,73 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "bench.h"
+#include "common.h"
+
+/*
+<testinfo>
+test_generator="gens/api-omp-generator -a --barrier=centralized|--barrier=old-centralized|--barrier=tree|--barrier=hierarchical"
+test_generator_ENV=( "NX_TEST_MODE=performance" )
+test_LDFLAGS="-lm"
+</testinfo>
+*/
+
+// TEST: Barrier latency ***************************************************************************
+// Every thread of the team goes through BARRIER_REPS team barriers; the master reports the time
+// per barrier. Each execution version uses one of the barrier plugins that are built.
+#define BARRIER_REPS  TEST_NTASKS
+
+typedef struct { stats_t *s; } barrier_args_t;
+
+static void barrier_region ( barrier_args_t *args )
+{
+   int i, j;
+   double times[TEST_NSAMPLES];
+
+   bench_enter_parallel();
+
+   for ( i = 0; i < TEST_NSAMPLES; i++ ) {
+      times[i] = GET_TIME;
+      for ( j = 0; j < BARRIER_REPS; j++ ) {
+         NANOS_SAFE( nanos_team_barrier() );
+      }
+      times[i] = ( GET_TIME - times[i] ) / BARRIER_REPS;
+   }
+   if ( omp_get_thread_num() == 0 ) stats( args->s, times, TEST_NSAMPLES );
+
+   bench_leave_parallel();
+}
+
+BENCH_WD_DEF( barrier_def, barrier_region, barrier_args_t, 1 );
+
+int main ( int argc, char *argv[] )
+{
+   stats_t s;
+   barrier_args_t args = { &s };
+   char name[128];
+
+   snprintf( name, sizeof( name ), "Barrier latency %s (usecs per barrier)", bench_barrier_name() );
+
+   bench_parallel( &barrier_def, &args, sizeof( args ) );
+   print_stats ( name, "warm-up", &s );
+   bench_parallel( &barrier_def, &args, sizeof( args ) );
+   print_stats ( name, "test", &s );
+
+   return 0;
+}
@@ -0,0 +1,143 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+/*
+ * Helpers for the benchmarks written directly against the Nanos++ C API. They
+ * follow the code Mercurium generates for tasks and parallel regions, so the
+ * benchmarks do not need the compiler to be built.
+ */
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+#include <string.h>
+#include <stdlib.h>
+#include "nanos.h"
+#include "nanos_omp.h"
+#include "omp.h"
+
+/* Constant part of a task (or implicit task) definition with one SMP device */
+typedef struct {
+   nanos_const_wd_definition_t base;
+   nanos_device_t devices[1];
+} bench_wd_def_t;
+
+#define BENCH_WD_DEF( name, outline, args_t, tied_ ) \
+   static nanos_smp_args_t name##_smp_args = { (void (*)(void *)) (outline) }; \
+   static bench_wd_def_t name = { \
+      { { .mandatory_creation = 1, .tied = (tied_) }, __alignof__(args_t), 0, 1, 0, #outline }, \
+      { NANOS_SMP_DESC( name##_smp_args ) } \
+   }
+
+/* Initializes a data access over one contiguous object */
+static inline void bench_dep ( nanos_data_access_t *dep, nanos_region_dimension_internal_t *dim,
+                               void *addr, size_t size, bool input, bool output )
+{
+   dim->size = size;
+   dim->lower_bound = 0;
+   dim->accessed_length = size;
+
+   memset( dep, 0, sizeof( nanos_data_access_t ) );
+   dep->address = addr;
+   dep->flags.input = input;
+   dep->flags.output = output;
+   dep->dimension_count = 1;
+   dep->dimensions = dim;
+   dep->offset = 0;
+}
+
+/* Creates a task running def over a copy of args and submits it */
+static inline void bench_task ( bench_wd_def_t *def, void *args, size_t args_size,
+                                size_t num_deps, nanos_data_access_t *deps )
+{
+   nanos_wd_t wd = NULL;
+   void *data = NULL;
+   nanos_wd_dyn_props_t dyn_props;
+
+   memset( &dyn_props, 0, sizeof( dyn_props ) );
+   NANOS_SAFE( nanos_create_wd_compact( &wd, &def->base, &dyn_props, args_size, &data,
+                                        nanos_current_wd(), NULL, NULL ) );
+   if ( args_size != 0 ) memcpy( data, args, args_size );
+   NANOS_SAFE( nanos_submit( wd, num_deps, deps, NULL ) );
+}
+
+static inline void bench_taskwait ( void )
+{
+   NANOS_SAFE( nanos_wg_wait_completion( nanos_current_wd(), false ) );
+}
+
+/* Runs def over args in a parallel region with the default number of threads.
+ * def must be tied; its outline has to call bench_enter_parallel and
+ * bench_leave_parallel around its body. */
+static inline void bench_parallel ( bench_wd_def_t *def, void *args, size_t args_size )
+{
+   unsigned int i, nthreads = nanos_omp_get_num_threads_next_parallel( 0 );
+   nanos_team_t team = NULL;
+   nanos_thread_t threads[nthreads];
+   nanos_wd_dyn_props_t dyn_props;
+
+   NANOS_SAFE( nanos_create_team( &team, NULL, &nthreads, NULL, true, threads, &def->base ) );
+
+   memset( &dyn_props, 0, sizeof( dyn_props ) );
+   for ( i = 1; i < nthreads; i++ ) {
+      nanos_wd_t wd = NULL;
+      void *data = NULL;
+      dyn_props.tie_to = threads[i];
+      NANOS_SAFE( nanos_create_wd_compact( &wd, &def->base, &dyn_props, args_size, &data,
+                                           nanos_current_wd(), NULL, NULL ) );
+      if ( args_size != 0 ) memcpy( data, args, args_size );
+      NANOS_SAFE( nanos_submit( wd, 0, NULL, NULL ) );
+   }
+
+   dyn_props.tie_to = threads[0];
+   NANOS_SAFE( nanos_create_wd_and_run_compact( &def->base, &dyn_props, args_size, args, 0, NULL, NULL, NULL, NULL ) );
+
+   NANOS_SAFE( nanos_end_team( team ) );
+}
+
+static inline void bench_enter_parallel ( void )
+{
+   NANOS_SAFE( nanos_omp_set_implicit( nanos_current_wd() ) );
+   NANOS_SAFE( nanos_enter_team() );
+}
+
+static inline void bench_leave_parallel ( void )
+{
+   NANOS_SAFE( nanos_omp_barrier() );
+   NANOS_SAFE( nanos_leave_team() );
+}
+
+/* Barrier plugin requested in NX_ARGS, as the result records do not include it */
+static inline const char * bench_barrier_name ( void )
+{
+   static char name[32] = "default";
+   const char *nx_args = getenv( "NX_ARGS" );
+   const char *barrier = nx_args != NULL ? strstr( nx_args, "--barrier=" ) : NULL;
+
+   if ( barrier != NULL ) {
+      barrier += strlen( "--barrier=" );
+      size_t len = strcspn( barrier, " " );
+      if ( len >= sizeof( name ) ) len = sizeof( name ) - 1;
+      memcpy( name, barrier, len );
+      name[len] = '\0';
+   }
+   return name;
+}
+
+#endif
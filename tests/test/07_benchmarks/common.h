@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <time.h>
+#include <unistd.h>
 #include "nanos.h"
 
 double get_usecs () {
@@ -66,6 +67,7 @@ void stats ( stats_t *s, double *values, unsigned size )
   unsigned nr = 0;
   double total = 0.0, sumsq = 0.0;
 
+  s->min = 1.0e10; s->max = 0.0;
   for (i=0; i<size; i++){
     if ( s->min > values[i] ) s->min = values[i];
     if ( s->max < values[i] ) s->max = values[i];
@@ -104,6 +106,13 @@ void stats ( stats_t *s, double *values, unsigned size )
   s->outliers = ((double)(size - nr)) / size;
 }
 
+/* Prints one result record in a machine readable form, one line per record:
+ *
+ *    *:Nanos++:<days since epoch>:<name>:<desc>:<mean>:<sd>:<min>:<max>:<outliers ratio>:
+ *      <threads>:<mode>:<pm>:<binding>:<architecture>:<scheduler>
+ *
+ * Times are in microseconds unless the benchmark name says otherwise.
+ */
 void print_stats ( const char *name, const char *desc, stats_t *s )
 {
    bool binding;
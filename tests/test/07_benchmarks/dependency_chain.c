@@ -0,0 +1,76 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "bench.h"
+#include "common.h"
+
+/*
+<testinfo>
+test_generator=gens/api-omp-generator
+test_generator_ENV=( "NX_TEST_MODE=performance" )
+test_LDFLAGS="-lm"
+</testinfo>
+*/
+
+// TEST: Dependency chain latency ******************************************************************
+// Every task of the chain depends on the previous one through an inout access, so at most one
+// task is ready at any time; reports the time from one link to the next.
+#define CHAIN_LENGTH  (TEST_NTASKS * 20)
+
+typedef struct { int *x; } chain_args_t;
+static void chain_task ( chain_args_t *args ) { (*args->x)++; }
+
+void test_dependency_chain ( stats_t *s )
+{
+   BENCH_WD_DEF( chain_def, chain_task, chain_args_t, 0 );
+   int i, j, x = 0;
+   double times[TEST_NSAMPLES];
+   chain_args_t args = { &x };
+   nanos_data_access_t dep;
+   nanos_region_dimension_internal_t dim;
+
+   bench_dep( &dep, &dim, &x, sizeof( x ), true, true );
+
+   for ( i = 0; i < TEST_NSAMPLES; i++ ) {
+      times[i] = GET_TIME;
+      for ( j = 0; j < CHAIN_LENGTH; j++ ) {
+         bench_task( &chain_def, &args, sizeof( args ), 1, &dep );
+      }
+      bench_taskwait();
+      times[i] = ( GET_TIME - times[i] ) / CHAIN_LENGTH;
+   }
+
+   if ( x != TEST_NSAMPLES * CHAIN_LENGTH ) {
+      fprintf( stderr, "Dependency chain: wrong result %d\n", x );
+      exit( 1 );
+   }
+   stats( s, times, TEST_NSAMPLES );
+}
+
+int main ( int argc, char *argv[] )
+{
+   stats_t s;
+
+   test_dependency_chain( &s );
+   print_stats ( "Dependency chain latency (usecs per link)","warm-up", &s );
+   test_dependency_chain( &s );
+   print_stats ( "Dependency chain latency (usecs per link)","test", &s );
+
+   return 0;
+}
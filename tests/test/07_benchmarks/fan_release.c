@@ -0,0 +1,123 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "bench.h"
+#include "common.h"
+
+/*
+<testinfo>
+test_generator=gens/api-omp-generator
+test_generator_ENV=( "NX_TEST_MODE=performance" )
+test_LDFLAGS="-lm"
+</testinfo>
+*/
+
+// TEST: Fan-out and fan-in release ****************************************************************
+// Fan-out: one producer releases FAN_WIDTH readers when it finishes.
+// Fan-in: one consumer waits for FAN_WIDTH producers writing different objects.
+// Both report the time per released dependence.
+#define FAN_WIDTH  (TEST_NTASKS * 10)
+
+typedef struct { int *x; } fan_args_t;
+static void write_task ( fan_args_t *args ) { *args->x = 1; }
+static void read_task ( fan_args_t *args ) { if ( *args->x != 1 ) abort(); }
+
+static int fan_data[FAN_WIDTH];
+
+void test_fan_out ( stats_t *s )
+{
+   BENCH_WD_DEF( write_def, write_task, fan_args_t, 0 );
+   BENCH_WD_DEF( read_def, read_task, fan_args_t, 0 );
+   int i, j, x;
+   double times[TEST_NSAMPLES];
+   fan_args_t args = { &x };
+   nanos_data_access_t dep_out, dep_in;
+   nanos_region_dimension_internal_t dim_out, dim_in;
+
+   bench_dep( &dep_out, &dim_out, &x, sizeof( x ), false, true );
+   bench_dep( &dep_in, &dim_in, &x, sizeof( x ), true, false );
+
+   for ( i = 0; i < TEST_NSAMPLES; i++ ) {
+      x = 0;
+      times[i] = GET_TIME;
+      bench_task( &write_def, &args, sizeof( args ), 1, &dep_out );
+      for ( j = 0; j < FAN_WIDTH; j++ ) {
+         bench_task( &read_def, &args, sizeof( args ), 1, &dep_in );
+      }
+      bench_taskwait();
+      times[i] = ( GET_TIME - times[i] ) / FAN_WIDTH;
+   }
+   stats( s, times, TEST_NSAMPLES );
+}
+
+typedef struct { int *data; } fan_in_args_t;
+static void fan_in_task ( fan_in_args_t *args )
+{
+   int j;
+   for ( j = 0; j < FAN_WIDTH; j++ ) if ( args->data[j] != 1 ) abort();
+}
+
+void test_fan_in ( stats_t *s )
+{
+   BENCH_WD_DEF( write_def, write_task, fan_args_t, 0 );
+   BENCH_WD_DEF( fan_in_def, fan_in_task, fan_in_args_t, 0 );
+   int i, j;
+   double times[TEST_NSAMPLES];
+   fan_args_t args;
+   fan_in_args_t fan_in_args = { fan_data };
+   static nanos_data_access_t deps_in[FAN_WIDTH];
+   static nanos_region_dimension_internal_t dims_in[FAN_WIDTH];
+   nanos_data_access_t dep_out;
+   nanos_region_dimension_internal_t dim_out;
+
+   for ( j = 0; j < FAN_WIDTH; j++ ) {
+      bench_dep( &deps_in[j], &dims_in[j], &fan_data[j], sizeof( int ), true, false );
+   }
+
+   for ( i = 0; i < TEST_NSAMPLES; i++ ) {
+      for ( j = 0; j < FAN_WIDTH; j++ ) fan_data[j] = 0;
+      times[i] = GET_TIME;
+      for ( j = 0; j < FAN_WIDTH; j++ ) {
+         args.x = &fan_data[j];
+         bench_dep( &dep_out, &dim_out, &fan_data[j], sizeof( int ), false, true );
+         bench_task( &write_def, &args, sizeof( args ), 1, &dep_out );
+      }
+      bench_task( &fan_in_def, &fan_in_args, sizeof( fan_in_args ), FAN_WIDTH, deps_in );
+      bench_taskwait();
+      times[i] = ( GET_TIME - times[i] ) / FAN_WIDTH;
+   }
+   stats( s, times, TEST_NSAMPLES );
+}
+
+int main ( int argc, char *argv[] )
+{
+   stats_t s;
+
+   test_fan_out( &s );
+   print_stats ( "Fan-out release (usecs per successor)","warm-up", &s );
+   test_fan_out( &s );
+   print_stats ( "Fan-out release (usecs per successor)","test", &s );
+
+   test_fan_in( &s );
+   print_stats ( "Fan-in release (usecs per predecessor)","warm-up", &s );
+   test_fan_in( &s );
+   print_stats ( "Fan-in release (usecs per predecessor)","test", &s );
+
+   return 0;
+}
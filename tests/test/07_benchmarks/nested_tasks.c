@@ -0,0 +1,77 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "bench.h"
+#include "common.h"
+
+/*
+<testinfo>
+test_generator=gens/api-omp-generator
+test_generator_ENV=( "NX_TEST_MODE=performance" )
+test_LDFLAGS="-lm"
+</testinfo>
+*/
+
+// TEST: Nested task creation **********************************************************************
+// Binary tree of tasks where every inner task creates two children and waits for them; reports
+// the time per task of the whole tree.
+#define NESTED_DEPTH   10
+#define NESTED_NTASKS  ( ( 1 << ( NESTED_DEPTH + 1 ) ) - 1 )
+
+typedef struct { int depth; } nested_args_t;
+static void nested_task ( nested_args_t *args );
+
+BENCH_WD_DEF( nested_def, nested_task, nested_args_t, 0 );
+
+static void nested_task ( nested_args_t *args )
+{
+   if ( args->depth > 0 ) {
+      nested_args_t child = { args->depth - 1 };
+      bench_task( &nested_def, &child, sizeof( child ), 0, NULL );
+      bench_task( &nested_def, &child, sizeof( child ), 0, NULL );
+      bench_taskwait();
+   }
+}
+
+void test_nested_tasks ( stats_t *s )
+{
+   int i;
+   double times[TEST_NSAMPLES];
+   nested_args_t root = { NESTED_DEPTH };
+
+   for ( i = 0; i < TEST_NSAMPLES; i++ ) {
+      times[i] = GET_TIME;
+      bench_task( &nested_def, &root, sizeof( root ), 0, NULL );
+      bench_taskwait();
+      times[i] = ( GET_TIME - times[i] ) / NESTED_NTASKS;
+   }
+   stats( s, times, TEST_NSAMPLES );
+}
+
+int main ( int argc, char *argv[] )
+{
+   stats_t s;
+
+   test_nested_tasks( &s );
+   print_stats ( "Nested task creation (usecs per task)","warm-up", &s );
+   test_nested_tasks( &s );
+   print_stats ( "Nested task creation (usecs per task)","test", &s );
+
+   return 0;
+}
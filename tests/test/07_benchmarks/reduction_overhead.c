@@ -0,0 +1,143 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "bench.h"
+#include "common.h"
+#include <sched.h>
+
+/*
+<testinfo>
+test_generator="gens/api-omp-generator -a --barrier=centralized|--barrier=tree|--barrier=hierarchical"
+test_generator_ENV=( "NX_TEST_MODE=performance" )
+test_LDFLAGS="-lm"
+</testinfo>
+*/
+
+// TEST: Reduction overhead ************************************************************************
+// Each iteration registers a team reduction, lets every thread update its private copy and
+// closes it with a team barrier, which combines the private copies into the original. Reports
+// the time per reduction for a scalar and for an array of REDUCTION_LENGTH elements. The
+// centralized barrier combines all the private copies on the last thread to arrive while the
+// tree barrier folds them pairwise on its way up.
+#define REDUCTION_REPS    TEST_NTASKS
+#define REDUCTION_LENGTH  1024
+
+typedef struct {
+   stats_t *s;
+   int *original;
+   unsigned length;
+} reduction_args_t;
+
+static void reduction_add ( void *original, void *private_copy, int num_scalars )
+{
+   int i, *o = (int *) original, *p = (int *) private_copy;
+   for ( i = 0; i < num_scalars; i++ ) o[i] += p[i];
+}
+
+/* Incremented by the master once the reduction of the current iteration is registered */
+static volatile int registered = 0;
+
+static void reduction_region ( reduction_args_t *args )
+{
+   int i, j, tid, nthreads;
+   unsigned k;
+   double times[TEST_NSAMPLES];
+
+   bench_enter_parallel();
+   tid = omp_get_thread_num();
+   nthreads = omp_get_num_threads();
+
+   for ( i = 0; i < TEST_NSAMPLES; i++ ) {
+      times[i] = GET_TIME;
+      for ( j = 0; j < REDUCTION_REPS; j++ ) {
+         int *privates;
+
+         if ( tid == 0 ) {
+            nanos_reduction_t *red = NULL;
+
+            NANOS_SAFE( nanos_malloc( (void **) &red, sizeof( nanos_reduction_t ), __FILE__, __LINE__ ) );
+            NANOS_SAFE( nanos_malloc( &red->privates, nthreads * args->length * sizeof( int ), __FILE__, __LINE__ ) );
+            memset( red->privates, 0, nthreads * args->length * sizeof( int ) );
+            red->original = args->original;
+            red->element_size = args->length * sizeof( int );
+            red->num_scalars = args->length;
+            red->descriptor = red->privates;
+            red->bop = reduction_add;
+            red->vop = NULL;
+            red->cleanup = nanos_free0;
+            NANOS_SAFE( nanos_register_reduction( red ) );
+            __sync_synchronize();
+            registered++;
+         } else {
+            while ( registered == i * REDUCTION_REPS + j ) { sched_yield(); __sync_synchronize(); }
+         }
+
+         NANOS_SAFE( nanos_reduction_get_private_data( (void **) &privates, args->original ) );
+         for ( k = 0; k < args->length; k++ ) privates[tid * args->length + k] += 1;
+
+         NANOS_SAFE( nanos_team_barrier() );
+      }
+      times[i] = ( GET_TIME - times[i] ) / REDUCTION_REPS;
+   }
+
+   if ( tid == 0 ) {
+      for ( k = 0; k < args->length; k++ ) {
+         if ( args->original[k] != TEST_NSAMPLES * REDUCTION_REPS * nthreads ) {
+            fprintf( stderr, "Reduction: wrong result %d\n", args->original[k] );
+            exit( 1 );
+         }
+      }
+      stats( args->s, times, TEST_NSAMPLES );
+   }
+
+   bench_leave_parallel();
+}
+
+BENCH_WD_DEF( reduction_def, reduction_region, reduction_args_t, 1 );
+
+void test_reduction ( stats_t *s, int *original, unsigned length )
+{
+   reduction_args_t args = { s, original, length };
+
+   memset( original, 0, length * sizeof( int ) );
+   registered = 0;
+   bench_parallel( &reduction_def, &args, sizeof( args ) );
+}
+
+int main ( int argc, char *argv[] )
+{
+   static int array[REDUCTION_LENGTH];
+   int scalar;
+   stats_t s;
+   char name[128];
+
+   snprintf( name, sizeof( name ), "Scalar reduction %s (usecs per reduction)", bench_barrier_name() );
+   test_reduction( &s, &scalar, 1 );
+   print_stats ( name, "warm-up", &s );
+   test_reduction( &s, &scalar, 1 );
+   print_stats ( name, "test", &s );
+
+   snprintf( name, sizeof( name ), "Array reduction %s (usecs per reduction)", bench_barrier_name() );
+   test_reduction( &s, array, REDUCTION_LENGTH );
+   print_stats ( name, "warm-up", &s );
+   test_reduction( &s, array, REDUCTION_LENGTH );
+   print_stats ( name, "test", &s );
+
+   return 0;
+}
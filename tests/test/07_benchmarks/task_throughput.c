@@ -0,0 +1,66 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "bench.h"
+#include "common.h"
+
+/*
+<testinfo>
+test_generator=gens/api-omp-generator
+test_generator_ENV=( "NX_TEST_MODE=performance" )
+test_LDFLAGS="-lm"
+</testinfo>
+*/
+
+// TEST: Empty task throughput *********************************************************************
+// Creates and runs batches of empty tasks; reports the time per task (1/throughput) for the
+// number of threads of each execution version.
+#define THROUGHPUT_NTASKS  (TEST_NTASKS * 20)
+
+typedef struct { int unused; } empty_args_t;
+static void empty_task ( empty_args_t *args ) { }
+
+void test_task_throughput ( stats_t *s )
+{
+   BENCH_WD_DEF( empty_def, empty_task, empty_args_t, 0 );
+   int i, j;
+   double times[TEST_NSAMPLES];
+
+   for ( i = 0; i < TEST_NSAMPLES; i++ ) {
+      times[i] = GET_TIME;
+      for ( j = 0; j < THROUGHPUT_NTASKS; j++ ) {
+         bench_task( &empty_def, NULL, 0, 0, NULL );
+      }
+      bench_taskwait();
+      times[i] = ( GET_TIME - times[i] ) / THROUGHPUT_NTASKS;
+   }
+   stats( s, times, TEST_NSAMPLES );
+}
+
+int main ( int argc, char *argv[] )
+{
+   stats_t s;
+
+   test_task_throughput( &s );
+   print_stats ( "Empty task throughput (usecs per task)","warm-up", &s );
+   test_task_throughput( &s );
+   print_stats ( "Empty task throughput (usecs per task)","test", &s );
+
+   return 0;
+}
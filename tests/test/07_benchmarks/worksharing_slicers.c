@@ -0,0 +1,107 @@
+/*************************************************************************************/
+/*      Copyright 2015 Barcelona Supercomputing Center                               */
+/*                                                                                   */
+/*      This file is part of the NANOS++ library.                                    */
+/*                                                                                   */
+/*      NANOS++ is free software: you can redistribute it and/or modify              */
+/*      it under the terms of the GNU Lesser General Public License as published by  */
+/*      the Free Software Foundation, either version 3 of the License, or            */
+/*      (at your option) any later version.                                          */
+/*                                                                                   */
+/*      NANOS++ is distributed in the hope that it will be useful,                   */
+/*      but WITHOUT ANY WARRANTY; without even the implied warranty of               */
+/*      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                */
+/*      GNU Lesser General Public License for more details.                          */
+/*                                                                                   */
+/*      You should have received a copy of the GNU Lesser General Public License     */
+/*      along with NANOS++.  If not, see <http://www.gnu.org/licenses/>.             */
+/*************************************************************************************/
+
+#include "bench.h"
+#include "common.h"
+
+/*
+<testinfo>
+test_generator=gens/api-omp-generator
+test_generator_ENV=( "NX_TEST_MODE=performance" )
+test_LDFLAGS="-lm"
+</testinfo>
+*/
+
+// TEST: Worksharing loop overhead *****************************************************************
+// Runs an empty loop through each of the loop slicers and reports the time per chunk, which is
+// the cost the slicer adds to every piece of work it hands out.
+#define LOOP_ITERS   ( TEST_NTASKS * 10 )
+#define LOOP_CHUNK   1
+#define LOOP_REPS    10
+
+typedef struct {
+   nanos_loop_info_t loop_info;
+} loop_args_t;
+
+static void loop_body ( loop_args_t *args )
+{
+   int i;
+   for ( i = args->loop_info.lower; i <= args->loop_info.upper; i += args->loop_info.step ) {
+      __asm__ __volatile__ ( "" ::: "memory" );
+   }
+}
+
+static nanos_smp_args_t loop_smp_args = { (void (*)(void *)) loop_body };
+
+void test_slicer ( const char *slicer_name, stats_t *s )
+{
+   nanos_device_t loop_device[1] = { NANOS_SMP_DESC( loop_smp_args ) };
+   nanos_wd_props_t props;
+   nanos_wd_dyn_props_t dyn_props;
+   nanos_slicer_t slicer = nanos_find_slicer( slicer_name );
+   int i, j;
+   double times[TEST_NSAMPLES];
+
+   memset( &props, 0, sizeof( props ) );
+   props.mandatory_creation = true;
+   memset( &dyn_props, 0, sizeof( dyn_props ) );
+
+   if ( slicer == NULL ) {
+      fprintf( stderr, "Slicer %s not found\n", slicer_name );
+      exit( 1 );
+   }
+
+   for ( i = 0; i < TEST_NSAMPLES; i++ ) {
+      times[i] = GET_TIME;
+      for ( j = 0; j < LOOP_REPS; j++ ) {
+         nanos_wd_t wd = NULL;
+         loop_args_t *args = NULL;
+
+         NANOS_SAFE( nanos_create_sliced_wd( &wd, 1, loop_device, sizeof( loop_args_t ), __alignof__( loop_args_t ),
+                                             (void **) &args, nanos_current_wd(), slicer, &props, &dyn_props,
+                                             0, NULL, 0, NULL ) );
+         args->loop_info.lower = 0;
+         args->loop_info.upper = LOOP_ITERS - 1;
+         args->loop_info.step = 1;
+         args->loop_info.chunk = LOOP_CHUNK;
+         NANOS_SAFE( nanos_submit( wd, 0, NULL, NULL ) );
+         bench_taskwait();
+      }
+      times[i] = ( GET_TIME - times[i] ) / ( LOOP_REPS * ( LOOP_ITERS / LOOP_CHUNK ) );
+   }
+   stats( s, times, TEST_NSAMPLES );
+}
+
+int main ( int argc, char *argv[] )
+{
+   const char *slicers[] = { "static_for", "dynamic_for", "guided_for" };
+   char name[64];
+   stats_t s;
+   unsigned i;
+
+   for ( i = 0; i < sizeof( slicers ) / sizeof( slicers[0] ); i++ ) {
+      snprintf( name, sizeof( name ), "Worksharing %s (usecs per chunk)", slicers[i] );
+      test_slicer( slicers[i], &s );
+      print_stats ( name, "warm-up", &s );
+      test_slicer( slicers[i], &s );
+      print_stats ( name, "test", &s );
+   }
+
+   return 0;
+}